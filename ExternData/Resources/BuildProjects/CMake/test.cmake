@@ -39,6 +39,7 @@ if(EXISTS "${ED_TEST_DIR}")
     Test_ED_JSON
     Test_ED_MAT
     Test_ED_XLS
+    Test_ED_XLSB
     Test_ED_XLSX
     Test_ED_XML
     Test_ED_XML2
@@ -56,6 +57,7 @@ if(EXISTS "${ED_TEST_DIR}")
       ED_JSONFile
       ED_MATFile
       ED_XLSFile
+      ED_XLSBFile
       ED_XLSXFile
       ED_XML2File
       ED_XMLFile
@@ -72,7 +74,7 @@ if(EXISTS "${ED_TEST_DIR}")
       gtest
     )
     if(UNIX)
-      list(APPEND ED_ALL_LIBS m)
+      list(APPEND ED_ALL_LIBS m pthread)
     endif()
     target_link_libraries(${TEST} PRIVATE ${ED_ALL_LIBS})
 
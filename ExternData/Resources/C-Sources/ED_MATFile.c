@@ -10,20 +10,74 @@
 #define _GNU_SOURCE 1
 #endif
 
+#include <limits.h>
 #include <string.h>
 #include <stdio.h>
 #if defined(_MSC_VER)
 #define strdup _strdup
 #endif
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define ED_HAVE_MMAP 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ED_HAVE_MMAP 1
+#endif
 #include "ED_ptrtrack.h"
 #include "ED_MATFile.h"
-#include "ModelicaIO.h"
 #include "ModelicaMatIO.h"
 #include "ModelicaUtilities.h"
+#define HASH_NONFATAL_OOM 1
+#include "uthash.h"
+
+/* Maximum size in bytes of a column of a transposed simulation result matrix
+   to read signals by whole columns */
+#define MAX_READ_COLUMN_SIZE (4096)
+/* Number of values per block read of whole columns */
+#define READ_BLOCK_LENGTH (65536)
+
+typedef struct VarShare {
+	char* varName; /* Full (possibly dot-separated) variable name */
+	matvar_t* matvar; /* Variable information, owned if isRoot == 1 */
+	int isRoot;
+	struct VarShare* parent; /* Struct of a field, NULL if isRoot == 1 */
+	/* Location in the file mapping, see locateVar */
+	int isLocated;
+	size_t arrayPos; /* Position of the MAT v5 array element, 0 if not available */
+	size_t dataPos; /* Position of the real part, 0 if not available */
+	size_t dataBytes;
+	mat_uint32_t dataType;
+	UT_hash_handle hh; /* Hashable structure */
+} VarShare;
+
+typedef struct {
+	char* name; /* Signal name of simulation result file */
+	int data; /* = 1: Stored in data_1, = 2: Stored in data_2 */
+	size_t idx; /* Zero-based row (transposed) or column index in data_1/data_2 */
+	int sign; /* = -1: Negated alias, = 1: Otherwise */
+	UT_hash_handle hh; /* Hashable structure */
+} SignalShare;
 
 typedef struct {
 	char* fileName;
 	int verbose;
+	/* Opened on first variable access and kept open until the handle is
+	   destroyed, since the indexed variables of MAT v7.3 files refer to HDF5
+	   objects of the open file. Meanwhile the file uses a descriptor and
+	   cannot be deleted or replaced on Windows. */
+	mat_t* mat;
+	VarShare* vars; /* Index of resolved variables and struct fields */
+	SignalShare* signals; /* Index of simulation result signals, built on first trajectory access */
+	int isTransposed; /* = 1: Simulation result file of binTrans format */
+	const unsigned char* map; /* Read-only file mapping of uncompressed MAT v4/v5 file */
+	size_t mapSize;
+	int mapState; /* = 0: Not yet mapped, = 1: Mapped, = -1: Mapping not available */
 } MATFile;
 
 void* ED_createMAT(const char* fileName, int verbose)
@@ -40,6 +94,13 @@ void* ED_createMAT(const char* fileName, int verbose)
 		return NULL;
 	}
 	mat->verbose = verbose;
+	mat->mat = NULL;
+	mat->vars = NULL;
+	mat->signals = NULL;
+	mat->isTransposed = 0;
+	mat->map = NULL;
+	mat->mapSize = 0;
+	mat->mapState = 0;
 	ED_PTR_ADD(mat);
 	return mat;
 }
@@ -49,20 +110,759 @@ void ED_destroyMAT(void* _mat)
 	MATFile* mat = (MATFile*)_mat;
 	ED_PTR_CHECK(mat);
 	if (mat != NULL) {
+		VarShare* iter;
+		VarShare* tmp;
+		SignalShare* signal;
+		SignalShare* signalTmp;
 		if (mat->fileName != NULL) {
 			free(mat->fileName);
 		}
+		HASH_ITER(hh, mat->signals, signal, signalTmp) {
+			HASH_DEL(mat->signals, signal);
+			free(signal->name);
+			free(signal);
+		}
+		HASH_ITER(hh, mat->vars, iter, tmp) {
+			HASH_DEL(mat->vars, iter);
+			if (iter->isRoot == 1) {
+				Mat_VarFree(iter->matvar);
+			}
+			free(iter->varName);
+			free(iter);
+		}
+		if (mat->map != NULL) {
+#if defined(_WIN32)
+			(void)UnmapViewOfFile(mat->map);
+#elif defined(ED_HAVE_MMAP)
+			(void)munmap((void*)mat->map, mat->mapSize);
+#endif
+		}
+		if (mat->mat != NULL) {
+			(void)Mat_Close(mat->mat);
+		}
 		free(mat);
 		ED_PTR_DEL(mat);
 	}
 }
 
+static void addVar(MATFile* mat, const char* varName, matvar_t* matvar, VarShare* parent)
+{
+	VarShare* iter = (VarShare*)calloc(1, sizeof(VarShare));
+	if (iter != NULL) {
+		iter->varName = strdup(varName);
+		if (iter->varName == NULL) {
+			free(iter);
+			return;
+		}
+		iter->matvar = matvar;
+		iter->isRoot = parent == NULL ? 1 : 0;
+		iter->parent = parent;
+		HASH_ADD_KEYPTR(hh, mat->vars, iter->varName, strlen(iter->varName), iter);
+		if (NULL == iter->hh.tbl) {
+			free(iter->varName);
+			free(iter);
+		}
+	}
+}
+
+static matvar_t* findVar(MATFile* mat, const char* varName)
+{
+	/* Resolve variable by its (dot-separated) name. Struct variables are read
+	   once per handle, the fields along the path are indexed by their prefix,
+	   such that each level of a struct hierarchy is only looked up once. */
+	VarShare* iter;
+	matvar_t* matvar = NULL;
+	const char* dot;
+
+	HASH_FIND_STR(mat->vars, varName, iter);
+	if (iter != NULL) {
+		return iter->matvar;
+	}
+
+	if (mat->mat == NULL) {
+		mat->mat = Mat_Open(mat->fileName, (int)MAT_ACC_RDONLY);
+		if (mat->mat == NULL) {
+			ModelicaFormatError("Not possible to open file \"%s\": "
+				"No such file or directory\n", mat->fileName);
+			return NULL;
+		}
+	}
+
+	dot = strrchr(varName, '.');
+	if (dot == NULL) {
+		matvar = Mat_VarReadInfo(mat->mat, varName);
+		if (matvar == NULL) {
+			ModelicaFormatError("Variable \"%s\" not found in file \"%s\".\n",
+				varName, mat->fileName);
+			return NULL;
+		}
+		addVar(mat, varName, matvar, NULL);
+		HASH_FIND_STR(mat->vars, varName, iter);
+		if (iter == NULL) {
+			Mat_VarFree(matvar);
+			ModelicaError("Memory allocation error\n");
+			return NULL;
+		}
+	}
+	else {
+		matvar_t* parent;
+		VarShare* parentShare = NULL;
+		char* parentName = (char*)malloc((dot - varName + 1)*sizeof(char));
+		if (parentName == NULL) {
+			ModelicaError("Memory allocation error\n");
+			return NULL;
+		}
+		strncpy(parentName, varName, dot - varName);
+		parentName[dot - varName] = '\0';
+		parent = findVar(mat, parentName);
+		HASH_FIND_STR(mat->vars, parentName, parentShare);
+		free(parentName);
+		if (parent != NULL) {
+			if (parent->class_type != MAT_C_STRUCT) {
+				ModelicaFormatError("Variable \"%.*s\" of \"%s\" is not a struct array.\n",
+					(int)(dot - varName), varName, varName);
+				return NULL;
+			}
+			if (parent->rank != 2) {
+				ModelicaFormatError("Variable \"%.*s\" of \"%s\" is not a struct array "
+					"of rank 2.\n", (int)(dot - varName), varName, varName);
+				return NULL;
+			}
+			if (parent->dims[0] != 1 || parent->dims[1] != 1) {
+				ModelicaFormatError("Variable \"%.*s\" of \"%s\" is not a 1x1 struct array.\n",
+					(int)(dot - varName), varName, varName);
+				return NULL;
+			}
+			matvar = Mat_VarGetStructField(parent, (void*)(dot + 1), MAT_BY_NAME, 0);
+		}
+		if (matvar == NULL) {
+			ModelicaFormatError("Variable \"%s\" not found in file \"%s\".\n",
+				varName, mat->fileName);
+			return NULL;
+		}
+		if (parentShare == NULL) {
+			/* Parent not indexed (out of memory): leave the field unlocated */
+			return matvar;
+		}
+		addVar(mat, varName, matvar, parentShare);
+	}
+	return matvar;
+}
+
+static matvar_t* findMatrix(MATFile* mat, const char* varName)
+{
+	matvar_t* matvar = findVar(mat, varName);
+	if (matvar != NULL && matvar->rank != 2) {
+		ModelicaFormatError("Variable \"%s\" is not of rank 2.\n", varName);
+		return NULL;
+	}
+	return matvar;
+}
+
+static matvar_t* findRealMatrix(MATFile* mat, const char* varName)
+{
+	matvar_t* matvar = findMatrix(mat, varName);
+	if (matvar != NULL) {
+		/* Check if variable class of matvar is numeric (and thus non-sparse) */
+		if (matvar->class_type != MAT_C_DOUBLE && matvar->class_type != MAT_C_SINGLE &&
+			matvar->class_type != MAT_C_INT8 && matvar->class_type != MAT_C_UINT8 &&
+			matvar->class_type != MAT_C_INT16 && matvar->class_type != MAT_C_UINT16 &&
+			matvar->class_type != MAT_C_INT32 && matvar->class_type != MAT_C_UINT32 &&
+			matvar->class_type != MAT_C_INT64 && matvar->class_type != MAT_C_UINT64) {
+			ModelicaFormatError("Matrix \"%s\" is not a "
+				"numeric array.\n", varName);
+			return NULL;
+		}
+
+		/* Check if matvar is purely real-valued */
+		if (matvar->isComplex) {
+			ModelicaFormatError("Matrix \"%s\" must not be complex.\n",
+				varName);
+			return NULL;
+		}
+	}
+	return matvar;
+}
+
+static matvar_t* findRealMatrixOfSize(MATFile* mat, const char* varName, size_t m, size_t n)
+{
+	matvar_t* matvar = findRealMatrix(mat, varName);
+	if (matvar != NULL) {
+		/* Check if number of rows matches */
+		if (m != matvar->dims[0]) {
+			ModelicaFormatError(
+				"Cannot read %lu rows of array \"%s(%lu,%lu)\" "
+				"from file \"%s\"\n", (unsigned long)m, varName,
+				(unsigned long)matvar->dims[0], (unsigned long)matvar->dims[1],
+				mat->fileName);
+			return NULL;
+		}
+
+		/* Check if number of columns matches */
+		if (n != matvar->dims[1]) {
+			ModelicaFormatError(
+				"Cannot read %lu columns of array \"%s(%lu,%lu)\" "
+				"from file \"%s\"\n", (unsigned long)n, varName,
+				(unsigned long)matvar->dims[0], (unsigned long)matvar->dims[1],
+				mat->fileName);
+			return NULL;
+		}
+	}
+	return matvar;
+}
+
+static void mapFile(MATFile* mat)
+{
+	/* Map the whole file read-only, such that the data of uncompressed
+	   variables is copied by page faults from the (shared) page cache */
+	mat->mapState = -1;
+	switch (Mat_GetVersion(mat->mat)) {
+		case MAT_FT_MAT4:
+		case MAT_FT_MAT5:
+			break;
+		default:
+			return;
+	}
+#if defined(_WIN32)
+	{
+		LARGE_INTEGER size;
+		HANDLE hMap;
+		HANDLE hFile = CreateFileA(mat->fileName, GENERIC_READ, FILE_SHARE_READ,
+			NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		if (!GetFileSizeEx(hFile, &size) || size.QuadPart <= 0 ||
+			(unsigned long long)size.QuadPart > (size_t)-1) {
+			CloseHandle(hFile);
+			return;
+		}
+		hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(hFile);
+		if (hMap == NULL) {
+			return;
+		}
+		/* The view keeps the mapping object alive */
+		mat->map = (const unsigned char*)MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(hMap);
+		if (mat->map != NULL) {
+			mat->mapSize = (size_t)size.QuadPart;
+			mat->mapState = 1;
+		}
+	}
+#elif defined(ED_HAVE_MMAP)
+	{
+		struct stat st;
+		void* map;
+		int fd = open(mat->fileName, O_RDONLY);
+		if (fd == -1) {
+			return;
+		}
+		if (fstat(fd, &st) != 0 || st.st_size <= 0 ||
+			(unsigned long long)st.st_size > (size_t)-1) {
+			close(fd);
+			return;
+		}
+		map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (map != MAP_FAILED) {
+			mat->map = (const unsigned char*)map;
+			mat->mapSize = (size_t)st.st_size;
+			mat->mapState = 1;
+		}
+	}
+#endif
+}
+
+static int readTag5(const MATFile* mat, size_t pos, size_t end, mat_uint32_t* type, size_t* nbytes, size_t* dataPos)
+{
+	/* Read the tag of a native-endian MAT v5 data element within [pos, end),
+	   which is either a regular or a small data element */
+	mat_uint32_t tag[2];
+	if (pos > end || end - pos < 8) {
+		return 0;
+	}
+	memcpy(tag, mat->map + pos, sizeof(tag));
+	if ((tag[0] & 0xffff0000) != 0) {
+		*type = tag[0] & 0x0000ffff;
+		*nbytes = tag[0] >> 16;
+		*dataPos = pos + 4;
+		return *nbytes <= 4;
+	}
+	*type = tag[0];
+	*nbytes = tag[1];
+	*dataPos = pos + 8;
+	return *nbytes <= end - *dataPos;
+}
+
+static size_t nextSubElement5(size_t pos, size_t nbytes, size_t dataPos)
+{
+	/* Subelements are padded to 8 bytes, small data elements take 8 bytes */
+	return dataPos == pos + 4 ? pos + 8 : dataPos + ((nbytes + 7) & ~(size_t)7);
+}
+
+static int readArrayHeader5(const MATFile* mat, size_t pos, size_t* end, mat_uint32_t* flags,
+	const char** name, size_t* nameLen, size_t* next)
+{
+	/* Read the array flags and the name of a MAT v5 array element at pos and
+	   get the position of its first subelement after the name */
+	mat_uint32_t type;
+	size_t nbytes, dataPos;
+	if (!readTag5(mat, pos, mat->mapSize, &type, &nbytes, &dataPos) ||
+		type != MAT_T_MATRIX || dataPos != pos + 8) {
+		return 0;
+	}
+	*end = dataPos + nbytes;
+	pos = dataPos;
+	if (!readTag5(mat, pos, *end, &type, &nbytes, &dataPos) ||
+		type != MAT_T_UINT32 || nbytes != 8) {
+		return 0;
+	}
+	memcpy(flags, mat->map + dataPos, sizeof(mat_uint32_t));
+	pos = nextSubElement5(pos, nbytes, dataPos);
+	if (!readTag5(mat, pos, *end, &type, &nbytes, &dataPos) || type != MAT_T_INT32) {
+		return 0;
+	}
+	pos = nextSubElement5(pos, nbytes, dataPos);
+	if (!readTag5(mat, pos, *end, &type, &nbytes, &dataPos) || type != MAT_T_INT8) {
+		return 0;
+	}
+	*name = (const char*)mat->map + dataPos;
+	*nameLen = nbytes;
+	*next = nextSubElement5(pos, nbytes, dataPos);
+	return *next <= *end;
+}
+
+static size_t findField5(const MATFile* mat, size_t pos, size_t end, const char* fieldName, size_t len)
+{
+	/* Get the position of the array element of a field of a 1x1 struct,
+	   where pos is the position of the field name length subelement */
+	mat_uint32_t type;
+	size_t nbytes, dataPos, nFields, i;
+	mat_int32_t fieldNameLen;
+	const char* fieldNames;
+	if (!readTag5(mat, pos, end, &type, &nbytes, &dataPos) ||
+		type != MAT_T_INT32 || nbytes != 4) {
+		return 0;
+	}
+	memcpy(&fieldNameLen, mat->map + dataPos, sizeof(mat_int32_t));
+	pos = nextSubElement5(pos, nbytes, dataPos);
+	if (fieldNameLen <= 0 || (size_t)fieldNameLen <= len ||
+		!readTag5(mat, pos, end, &type, &nbytes, &dataPos) || type != MAT_T_INT8) {
+		return 0;
+	}
+	fieldNames = (const char*)mat->map + dataPos;
+	nFields = nbytes/(size_t)fieldNameLen;
+	pos = nextSubElement5(pos, nbytes, dataPos);
+	for (i = 0; i < nFields; i++) {
+		const char* iter = fieldNames + i*(size_t)fieldNameLen;
+		if (strncmp(iter, fieldName, len) == 0 && iter[len] == '\0') {
+			break;
+		}
+	}
+	if (i == nFields) {
+		return 0;
+	}
+	/* The field arrays are stored in order of the field names */
+	for (; i > 0; i--) {
+		if (!readTag5(mat, pos, end, &type, &nbytes, &dataPos) || type != MAT_T_MATRIX) {
+			return 0;
+		}
+		pos = dataPos + nbytes;
+	}
+	return pos;
+}
+
+static size_t findArray5(const MATFile* mat, const char* varName)
+{
+	/* Walk the uncompressed top-level elements of a native-endian MAT v5
+	   file and get the position of the array element of a variable */
+	const mat_uint16_t endian = 0x4d49; /* "MI" */
+	const size_t len = strlen(varName);
+	size_t pos = 128;
+	if (mat->mapSize < pos || memcmp(mat->map + 126, &endian, sizeof(endian)) != 0) {
+		return 0;
+	}
+	/* Top-level (compressed) elements are not padded */
+	for (;;) {
+		mat_uint32_t type, flags;
+		size_t nbytes, dataPos, end, next, nameLen;
+		const char* name;
+		if (!readTag5(mat, pos, mat->mapSize, &type, &nbytes, &dataPos) || dataPos != pos + 8) {
+			return 0;
+		}
+		if (type == MAT_T_MATRIX &&
+			readArrayHeader5(mat, pos, &end, &flags, &name, &nameLen, &next) &&
+			nameLen == len && strncmp(name, varName, len) == 0) {
+			return pos;
+		}
+		pos = dataPos + nbytes;
+	}
+}
+
+static size_t findMappedData4(const MATFile* mat, const char* varName, mat_uint32_t* type, size_t* nbytes)
+{
+	/* Walk the native-endian matrices of a MAT v4 file and get the position
+	   of the real part */
+	const int one = 1;
+	const mat_int32_t mOpt = *(const char*)&one == 1 ? 0 : 1; /* Machine format */
+	const size_t len = strlen(varName) + 1;
+	size_t pos = 0;
+	while (mat->mapSize - pos >= 5*sizeof(mat_int32_t)) {
+		mat_int32_t header[5]; /* type, mrows, ncols, imagf, namlen */
+		size_t n;
+		memcpy(header, mat->map + pos, sizeof(header));
+		if (header[0] < 0 || header[0] > 4052 || header[0]/1000 != mOpt ||
+			header[1] < 0 || header[2] < 0 || header[4] <= 0) {
+			return 0;
+		}
+		pos += sizeof(header);
+		if ((size_t)header[4] > mat->mapSize - pos) {
+			return 0;
+		}
+		switch ((header[0]/10) % 10) {
+			case 0: *type = MAT_T_DOUBLE; n = sizeof(mat_int64_t); break;
+			case 1: *type = MAT_T_SINGLE; n = sizeof(mat_int32_t); break;
+			case 2: *type = MAT_T_INT32; n = sizeof(mat_int32_t); break;
+			case 3: *type = MAT_T_INT16; n = sizeof(mat_int16_t); break;
+			case 4: *type = MAT_T_UINT16; n = sizeof(mat_uint16_t); break;
+			case 5: *type = MAT_T_UINT8; n = sizeof(mat_uint8_t); break;
+			default: return 0;
+		}
+		*nbytes = (size_t)header[1]*(size_t)header[2]*n;
+		if ((size_t)header[4] == len && memcmp(mat->map + pos, varName, len) == 0) {
+			pos += (size_t)header[4];
+			return *nbytes <= mat->mapSize - pos && header[0] % 10 == 0 ? pos : 0;
+		}
+		pos += (size_t)header[4];
+		if (*nbytes > (mat->mapSize - pos)/(header[3] != 0 ? 2 : 1)) {
+			return 0;
+		}
+		pos += *nbytes*(header[3] != 0 ? 2 : 1);
+	}
+	return 0;
+}
+
+static void locateVar(MATFile* mat, VarShare* var)
+{
+	/* Locate the real part of an uncompressed variable in the file mapping
+	   once. A struct field is located from the array element of its parent,
+	   such that each level of a struct hierarchy is only walked once.
+	   Compressed variables are a single zlib stream and are left to matio,
+	   which inflates the whole struct when reading any of its fields. */
+	mat_uint32_t flags;
+	size_t end, next, nameLen, dataPos;
+	const char* name;
+	if (var->isLocated == 1) {
+		return;
+	}
+	var->isLocated = 1;
+	if (Mat_GetVersion(mat->mat) == MAT_FT_MAT4) {
+		var->dataPos = findMappedData4(mat, var->varName, &var->dataType, &var->dataBytes);
+		return;
+	}
+	if (var->parent == NULL) {
+		var->arrayPos = findArray5(mat, var->varName);
+	}
+	else {
+		const char* fieldName = var->varName + strlen(var->parent->varName) + 1;
+		locateVar(mat, var->parent);
+		if (var->parent->arrayPos != 0 &&
+			readArrayHeader5(mat, var->parent->arrayPos, &end, &flags, &name, &nameLen, &next) &&
+			(flags & 0xff) == MAT_C_STRUCT) {
+			var->arrayPos = findField5(mat, next, end, fieldName, strlen(fieldName));
+		}
+	}
+	if (var->arrayPos == 0 ||
+		!readArrayHeader5(mat, var->arrayPos, &end, &flags, &name, &nameLen, &next) ||
+		(flags & 0xff) == MAT_C_STRUCT || (flags & 0xff) == MAT_C_CELL ||
+		(flags & 0xff) == MAT_C_SPARSE || (flags & 0xff) == MAT_C_CHAR ||
+		!readTag5(mat, next, end, &var->dataType, &var->dataBytes, &dataPos) ||
+		dataPos != next + 8) {
+		/* Data packed in the tag is left to matio */
+		return;
+	}
+	var->dataPos = dataPos;
+}
+
+static const unsigned char* findMappedData(MATFile* mat, const char* varName, const matvar_t* matvar, enum matio_types* data_type)
+{
+	/* Get the location of the real-valued, native-endian numeric data of
+	   an uncompressed variable in the file mapping, or NULL if the data
+	   needs to be read by matio. The data elements are located from the
+	   mapping itself, since matio does not expose the file positions. */
+	VarShare* var;
+	size_t nelems = 1;
+	int i;
+	HASH_FIND_STR(mat->vars, varName, var);
+	if (var == NULL) {
+		return NULL;
+	}
+	if (mat->mapState == 0) {
+		mapFile(mat);
+	}
+	if (mat->mapState != 1 || matvar->isComplex) {
+		return NULL;
+	}
+	locateVar(mat, var);
+	if (var->dataPos == 0 || Mat_SizeOf((enum matio_types)var->dataType) == 0 ||
+		var->dataType == MAT_T_UTF8 || var->dataType == MAT_T_UTF16 ||
+		var->dataType == MAT_T_UTF32) {
+		return NULL;
+	}
+	*data_type = (enum matio_types)var->dataType;
+	for (i = 0; i < matvar->rank; i++) {
+		nelems *= matvar->dims[i];
+	}
+	if (nelems > var->dataBytes/Mat_SizeOf(*data_type)) {
+		return NULL;
+	}
+	return mat->map + var->dataPos;
+}
+
+static double getMappedValue(const unsigned char* p, enum matio_types data_type)
+{
+	/* Get a numeric element, which is not necessarily aligned (MAT v4) */
+	switch (data_type) {
+		case MAT_T_DOUBLE: { double v; memcpy(&v, p, sizeof(v)); return v; }
+		case MAT_T_SINGLE: { float v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_INT64: { mat_int64_t v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_UINT64: { mat_uint64_t v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_INT32: { mat_int32_t v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_UINT32: { mat_uint32_t v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_INT16: { mat_int16_t v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_UINT16: { mat_uint16_t v; memcpy(&v, p, sizeof(v)); return (double)v; }
+		case MAT_T_INT8: return (double)*(const mat_int8_t*)p;
+		case MAT_T_UINT8: return (double)*(const mat_uint8_t*)p;
+		default: return 0.;
+	}
+}
+
+static void copyMappedData(const unsigned char* p, enum matio_types data_type, size_t first, size_t stride, size_t n, double* a)
+{
+	/* Copy n elements with element stride starting at element first */
+	size_t i;
+	const size_t size = Mat_SizeOf(data_type);
+	p += first*size;
+	if (data_type == MAT_T_DOUBLE) {
+		for (i = 0; i < n; i++, p += stride*sizeof(double)) {
+			memcpy(&a[i], p, sizeof(double));
+		}
+	}
+	else {
+		for (i = 0; i < n; i++, p += stride*size) {
+			a[i] = getMappedValue(p, data_type);
+		}
+	}
+}
+
+static int isIntValue(double value)
+{
+	/* Check if the value is in the range of int after truncation */
+	return value > (double)INT_MIN - 1. && value < (double)INT_MAX + 1.;
+}
+
+static int readSlab(MATFile* mat, matvar_t* matvar, enum matio_classes class_type, void* data,
+	int* start, int* stride, int* edge)
+{
+	/* Read the slab converted to the requested class in a single pass. The
+	   variable information is kept in the index and thus must be left
+	   unchanged. */
+	enum matio_classes _class_type = matvar->class_type;
+	enum matio_types data_type = matvar->data_type;
+	int data_size = matvar->data_size;
+	int err;
+	matvar->class_type = class_type;
+	err = Mat_VarReadData(mat->mat, matvar, data, start, stride, edge);
+	matvar->class_type = _class_type;
+	matvar->data_type = data_type;
+	matvar->data_size = data_size;
+	return err;
+}
+
+static int readData(MATFile* mat, matvar_t* matvar, enum matio_classes class_type, void* data)
+{
+	/* Read the column-wise stored data of a matrix */
+	int start[2] = {0, 0};
+	int stride[2] = {1, 1};
+	int edge[2];
+	edge[0] = (int)matvar->dims[0];
+	edge[1] = (int)matvar->dims[1];
+	return readSlab(mat, matvar, class_type, data, start, stride, edge);
+}
+
 void ED_getDoubleArray2DFromMAT(void* _mat, const char* varName, double* a, size_t m, size_t n)
 {
 	MATFile* mat = (MATFile*)_mat;
 	ED_PTR_CHECK(mat);
 	if (mat != NULL) {
-		ModelicaIO_readRealMatrix(mat->fileName, varName, a, m, n, mat->verbose);
+		matvar_t* matvar;
+
+		if (mat->verbose == 1) {
+			/* Print info message, that matrix / file is loading */
+			ModelicaFormatMessage("... loading \"%s\" from \"%s\"\n", varName, mat->fileName);
+		}
+
+		matvar = findRealMatrixOfSize(mat, varName, m, n);
+		if (matvar != NULL && m*n > 0) {
+			size_t i, j;
+			double* buf;
+			enum matio_types data_type;
+			const unsigned char* p = findMappedData(mat, varName, matvar, &data_type);
+			if (p != NULL) {
+				/* Transpose straight from the file mapping */
+				for (i = 0; i < m; i++) {
+					copyMappedData(p, data_type, i, m, n, &a[i*n]);
+				}
+				return;
+			}
+
+			buf = (double*)malloc(m*n*sizeof(double));
+			if (buf == NULL) {
+				ModelicaError("Memory allocation error\n");
+				return;
+			}
+			if (readData(mat, matvar, MAT_C_DOUBLE, buf) != 0) {
+				free(buf);
+				ModelicaFormatError(
+					"Error when reading numeric data of matrix \"%s(%lu,%lu)\" "
+					"from file \"%s\"\n", varName, (unsigned long)m,
+					(unsigned long)n, mat->fileName);
+				return;
+			}
+
+			/* Array is stored column-wise -> need to transpose */
+			for (j = 0; j < n; j++) {
+				for (i = 0; i < m; i++) {
+					a[i*n + j] = buf[j*m + i];
+				}
+			}
+			free(buf);
+		}
+	}
+}
+
+static void getIntArray2D(MATFile* mat, const char* varName, int* a, size_t m, size_t n, int isBoolean)
+{
+	matvar_t* matvar;
+
+	if (mat->verbose == 1) {
+		/* Print info message, that matrix / file is loading */
+		ModelicaFormatMessage("... loading \"%s\" from \"%s\"\n", varName, mat->fileName);
+	}
+
+	matvar = findRealMatrixOfSize(mat, varName, m, n);
+	if (matvar != NULL && m*n > 0) {
+		size_t i, j;
+		void* buf;
+		enum matio_types data_type;
+		enum matio_classes class_type;
+		const unsigned char* p = findMappedData(mat, varName, matvar, &data_type);
+		if (p != NULL) {
+			/* Convert and transpose straight from the file mapping */
+			const size_t size = Mat_SizeOf(data_type);
+			for (j = 0; j < n; j++) {
+				for (i = 0; i < m; i++, p += size) {
+					const double value = getMappedValue(p, data_type);
+					if (isBoolean == 1) {
+						a[i*n + j] = value != 0. ? 1 : 0;
+					}
+					else if (isIntValue(value)) {
+						a[i*n + j] = (int)value;
+					}
+					else {
+						ModelicaFormatError(
+							"Value %.17g of element (%lu,%lu) of matrix \"%s\" "
+							"from file \"%s\" is out of the Integer range\n", value,
+							(unsigned long)(i + 1), (unsigned long)(j + 1), varName,
+							mat->fileName);
+						return;
+					}
+				}
+			}
+			return;
+		}
+
+		/* Integer classes that fit into int32 are directly converted by the
+		   slab reader. Floating point and wider integer classes are read as
+		   double to check the range or keep the truth value. */
+		class_type = MAT_C_INT32;
+		if (matvar->class_type == MAT_C_DOUBLE || matvar->class_type == MAT_C_SINGLE ||
+			matvar->class_type == MAT_C_INT64 || matvar->class_type == MAT_C_UINT64 ||
+			matvar->class_type == MAT_C_UINT32) {
+			class_type = MAT_C_DOUBLE;
+		}
+		if (class_type == MAT_C_INT32 && isBoolean == 0 && (m == 1 || n == 1) &&
+			sizeof(int) == sizeof(mat_int32_t)) {
+			/* Vector storage order is the same, read into the destination */
+			if (readData(mat, matvar, class_type, a) != 0) {
+				ModelicaFormatError(
+					"Error when reading numeric data of matrix \"%s(%lu,%lu)\" "
+					"from file \"%s\"\n", varName, (unsigned long)m,
+					(unsigned long)n, mat->fileName);
+			}
+			return;
+		}
+		buf = malloc(m*n*(class_type == MAT_C_INT32 ? sizeof(mat_int32_t) : sizeof(double)));
+		if (buf == NULL) {
+			ModelicaError("Memory allocation error\n");
+			return;
+		}
+		if (readData(mat, matvar, class_type, buf) != 0) {
+			free(buf);
+			ModelicaFormatError(
+				"Error when reading numeric data of matrix \"%s(%lu,%lu)\" "
+				"from file \"%s\"\n", varName, (unsigned long)m,
+				(unsigned long)n, mat->fileName);
+			return;
+		}
+
+		/* Array is stored column-wise -> need to transpose */
+		for (j = 0; j < n; j++) {
+			for (i = 0; i < m; i++) {
+				if (class_type == MAT_C_INT32) {
+					const mat_int32_t value = ((const mat_int32_t*)buf)[j*m + i];
+					a[i*n + j] = isBoolean == 1 ? (value != 0 ? 1 : 0) : (int)value;
+				}
+				else {
+					const double value = ((const double*)buf)[j*m + i];
+					if (isBoolean == 1) {
+						a[i*n + j] = value != 0. ? 1 : 0;
+					}
+					else if (isIntValue(value)) {
+						a[i*n + j] = (int)value;
+					}
+					else {
+						free(buf);
+						ModelicaFormatError(
+							"Value %.17g of element (%lu,%lu) of matrix \"%s\" "
+							"from file \"%s\" is out of the Integer range\n", value,
+							(unsigned long)(i + 1), (unsigned long)(j + 1), varName,
+							mat->fileName);
+						return;
+					}
+				}
+			}
+		}
+		free(buf);
+	}
+}
+
+void ED_getIntArray2DFromMAT(void* _mat, const char* varName, int* a, size_t m, size_t n)
+{
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		getIntArray2D(mat, varName, a, m, n, 0);
+	}
+}
+
+void ED_getBooleanArray2DFromMAT(void* _mat, const char* varName, int* a, size_t m, size_t n)
+{
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		getIntArray2D(mat, varName, a, m, n, 1);
 	}
 }
 
@@ -71,22 +871,19 @@ void ED_getStringArray1DFromMAT(void* _mat, const char* varName, const char** a,
 	MATFile* mat = (MATFile*)_mat;
 	ED_PTR_CHECK(mat);
 	if (mat != NULL) {
-		MatIO matio = {NULL, NULL, NULL};
+		matvar_t* matvar;
 
 		if (mat->verbose == 1) {
 			/* Print info message, that matrix / file is loading */
 			ModelicaFormatMessage("... loading \"%s\" from \"%s\"\n", varName, mat->fileName);
 		}
 
-		readMatIO(mat->fileName, varName, &matio);
-		if (NULL != matio.matvar) {
-			matvar_t* matvar = matio.matvar;
+		matvar = findMatrix(mat, varName);
+		if (NULL != matvar) {
 			size_t nRow, nCol, i;
 
 			/* Check if matvar is of character class */
 			if (matvar->class_type != MAT_C_CHAR) {
-				Mat_VarFree(matio.matvarRoot);
-				(void)Mat_Close(matio.mat);
 				ModelicaFormatError("2D array \"%s\" has not the required "
 					"character class.\n", varName);
 				return;
@@ -97,8 +894,6 @@ void ED_getStringArray1DFromMAT(void* _mat, const char* varName, const char** a,
 
 			/* Check number of rows */
 			if (m > nRow) {
-				Mat_VarFree(matio.matvarRoot);
-				(void)Mat_Close(matio.mat);
 				ModelicaFormatError(
 					"Cannot read %lu rows of array \"%s(%lu,%lu)\" "
 					"from file \"%s\"\n", (unsigned long)m, varName,
@@ -106,7 +901,10 @@ void ED_getStringArray1DFromMAT(void* _mat, const char* varName, const char** a,
 				return;
 			}
 
-			(void)Mat_VarReadDataAll(matio.mat, matvar);
+			if (NULL == matvar->data) {
+				/* Character data is kept in the index once read */
+				(void)Mat_VarReadDataAll(mat->mat, matvar);
+			}
 
 			for (i = 0; i < m; i++) {
 				char* str = ModelicaAllocateStringWithErrorReturn(nCol);
@@ -120,15 +918,10 @@ void ED_getStringArray1DFromMAT(void* _mat, const char* varName, const char** a,
 					a[i] = str;
 				}
 				else {
-					Mat_VarFree(matio.matvarRoot);
-					(void)Mat_Close(matio.mat);
 					ModelicaError("Memory allocation error\n");
 					return;
 				}
 			}
-
-			Mat_VarFree(matio.matvarRoot);
-			(void)Mat_Close(matio.mat);
 		}
 	}
 }
@@ -144,13 +937,506 @@ void ED_getArray2DDimensionsFromMAT(void* _mat, const char* varName, int* m, int
 		*n = 0;
 	ED_PTR_CHECK(mat);
 	if (NULL != mat) {
-		int dim[2];
-		ModelicaIO_readMatrixSizes(mat->fileName, varName, dim);
-		_m = dim[0];
-		_n = dim[1];
+		matvar_t* matvar = findMatrix(mat, varName);
+		if (NULL != matvar && matvar->class_type != MAT_C_SPARSE) {
+			matvar = findRealMatrix(mat, varName);
+		}
+		if (NULL != matvar) {
+			_m = (int)matvar->dims[0];
+			_n = (int)matvar->dims[1];
+		}
 	}
 	if (NULL != m)
 		*m = _m;
 	if (NULL != n)
 		*n = _n;
 }
+
+static int isValidSparse(const mat_sparse_t* sparse, size_t m, size_t n)
+{
+	/* The column pointers must be non-decreasing and the row indices in
+	   range, since both are used as array indices when converting */
+	size_t j, k, nnz;
+	if (sparse->jc == NULL || sparse->njc <= n || sparse->jc[0] != 0) {
+		return 0;
+	}
+	for (j = 0; j < n; j++) {
+		if (sparse->jc[j] > sparse->jc[j + 1]) {
+			return 0;
+		}
+	}
+	nnz = (size_t)sparse->jc[n];
+	if (nnz > sparse->nir || nnz > sparse->ndata) {
+		return 0;
+	}
+	if (nnz > 0 && (sparse->ir == NULL || sparse->data == NULL)) {
+		return 0;
+	}
+	for (k = 0; k < nnz; k++) {
+		if (sparse->ir[k] >= m) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static mat_sparse_t* findSparseMatrix(MATFile* mat, const char* varName, size_t* m, size_t* n, size_t* nnz)
+{
+	mat_sparse_t* sparse;
+	matvar_t* matvar = findMatrix(mat, varName);
+	if (matvar == NULL) {
+		return NULL;
+	}
+
+	/* Check if matvar is of sparse class */
+	if (matvar->class_type != MAT_C_SPARSE) {
+		ModelicaFormatError("Matrix \"%s\" is not a sparse array.\n", varName);
+		return NULL;
+	}
+
+	/* Check if matvar is purely real-valued */
+	if (matvar->isComplex) {
+		ModelicaFormatError("Matrix \"%s\" must not be complex.\n",
+			varName);
+		return NULL;
+	}
+
+	if (NULL == matvar->data) {
+		/* Sparse data (ir, jc, data) is kept in the index once read */
+		if (Mat_VarReadDataAll(mat->mat, matvar) != 0 || NULL == matvar->data) {
+			ModelicaFormatError(
+				"Error when reading sparse data of matrix \"%s(%lu,%lu)\" "
+				"from file \"%s\"\n", varName, (unsigned long)matvar->dims[0],
+				(unsigned long)matvar->dims[1], mat->fileName);
+			return NULL;
+		}
+	}
+
+	sparse = (mat_sparse_t*)matvar->data;
+	*m = matvar->dims[0];
+	*n = matvar->dims[1];
+	*nnz = 0;
+	if (!isValidSparse(sparse, *m, *n)) {
+		ModelicaFormatError(
+			"Inconsistent sparse data of matrix \"%s(%lu,%lu)\" "
+			"in file \"%s\"\n", varName, (unsigned long)*m,
+			(unsigned long)*n, mat->fileName);
+		return NULL;
+	}
+	*nnz = (size_t)sparse->jc[*n];
+	return sparse;
+}
+
+int ED_getSparseNonZerosFromMAT(void* _mat, const char* varName)
+{
+	int nnz = 0;
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		size_t _m, _n, _nnz;
+		if (findSparseMatrix(mat, varName, &_m, &_n, &_nnz) != NULL) {
+			nnz = (int)_nnz;
+		}
+	}
+	return nnz;
+}
+
+void ED_getSparseDoubleArray2DFromMAT(void* _mat, const char* varName, int* rowPtr, int* colIdx, double* a, size_t m, size_t nnz)
+{
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		const mat_sparse_t* sparse;
+		size_t _m, _n, _nnz;
+
+		if (mat->verbose == 1) {
+			/* Print info message, that matrix / file is loading */
+			ModelicaFormatMessage("... loading \"%s\" from \"%s\"\n", varName, mat->fileName);
+		}
+
+		sparse = findSparseMatrix(mat, varName, &_m, &_n, &_nnz);
+		if (sparse != NULL) {
+			const double* data = (const double*)sparse->data;
+			size_t i, j;
+
+			if (m != _m) {
+				ModelicaFormatError(
+					"Cannot read %lu rows of sparse array \"%s(%lu,%lu)\" "
+					"from file \"%s\"\n", (unsigned long)m, varName,
+					(unsigned long)_m, (unsigned long)_n, mat->fileName);
+				return;
+			}
+			if (nnz != _nnz) {
+				ModelicaFormatError(
+					"Cannot read %lu non-zero elements of sparse array \"%s(%lu,%lu)\" "
+					"with %lu non-zero elements from file \"%s\"\n", (unsigned long)nnz,
+					varName, (unsigned long)_m, (unsigned long)_n, (unsigned long)_nnz,
+					mat->fileName);
+				return;
+			}
+
+			/* Convert the column-wise compressed storage (CSC) to compressed
+			   row storage (CSR) by counting the entries per row */
+			for (i = 0; i <= m; i++) {
+				rowPtr[i] = 0;
+			}
+			for (i = 0; i < nnz; i++) {
+				rowPtr[sparse->ir[i] + 1]++;
+			}
+			for (i = 0; i < m; i++) {
+				rowPtr[i + 1] += rowPtr[i];
+			}
+			for (j = 0; j < _n; j++) {
+				size_t k;
+				for (k = sparse->jc[j]; k < sparse->jc[j + 1]; k++) {
+					const int dest = rowPtr[sparse->ir[k]]++;
+					colIdx[dest] = (int)j + 1;
+					a[dest] = data[k];
+				}
+			}
+			/* Shift back the row pointers and make them one-based */
+			for (i = m; i > 0; i--) {
+				rowPtr[i] = rowPtr[i - 1] + 1;
+			}
+			rowPtr[0] = 1;
+		}
+	}
+}
+
+void ED_getDoubleArray2DFromSparseMAT(void* _mat, const char* varName, double* a, size_t m, size_t n)
+{
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		const mat_sparse_t* sparse;
+		size_t _m, _n, _nnz;
+
+		if (mat->verbose == 1) {
+			/* Print info message, that matrix / file is loading */
+			ModelicaFormatMessage("... loading \"%s\" from \"%s\"\n", varName, mat->fileName);
+		}
+
+		sparse = findSparseMatrix(mat, varName, &_m, &_n, &_nnz);
+		if (sparse != NULL) {
+			const double* data = (const double*)sparse->data;
+			size_t j;
+
+			if (m != _m || n != _n) {
+				ModelicaFormatError(
+					"Cannot read array of dimensions (%lu,%lu) from sparse array \"%s(%lu,%lu)\" "
+					"from file \"%s\"\n", (unsigned long)m, (unsigned long)n, varName,
+					(unsigned long)_m, (unsigned long)_n, mat->fileName);
+				return;
+			}
+
+			memset(a, 0, m*n*sizeof(double));
+			for (j = 0; j < n; j++) {
+				size_t k;
+				for (k = sparse->jc[j]; k < sparse->jc[j + 1]; k++) {
+					a[sparse->ir[k]*n + j] = data[k];
+				}
+			}
+		}
+	}
+}
+
+static void addSignal(MATFile* mat, const char* name, size_t len, int data, size_t idx, int sign)
+{
+	SignalShare* iter = (SignalShare*)malloc(sizeof(SignalShare));
+	if (iter != NULL) {
+		iter->name = (char*)malloc((len + 1)*sizeof(char));
+		if (iter->name == NULL) {
+			free(iter);
+			return;
+		}
+		strncpy(iter->name, name, len);
+		iter->name[len] = '\0';
+		iter->data = data;
+		iter->idx = idx;
+		iter->sign = sign;
+		HASH_ADD_KEYPTR(hh, mat->signals, iter->name, len, iter);
+		if (NULL == iter->hh.tbl) {
+			free(iter->name);
+			free(iter);
+		}
+	}
+}
+
+static void buildSignalIndex(MATFile* mat)
+{
+	/* Index the signal names of a simulation result file (Dymola/OpenModelica
+	   layout with variables Aclass, name, dataInfo, data_1 and data_2) once
+	   per handle. Aliases and their sign are resolved by dataInfo. */
+	matvar_t* name;
+	matvar_t* dataInfo;
+	mat_int32_t* info;
+	size_t nSignals, nLen, i;
+	int err;
+
+	if (mat->signals != NULL) {
+		return;
+	}
+
+	if (mat->verbose == 1) {
+		/* Print info message, that result file is loading */
+		ModelicaFormatMessage("... indexing signals of \"%s\"\n", mat->fileName);
+	}
+
+	{
+		/* Aclass(4,:) = "binTrans" if name, dataInfo and data_i are transposed */
+		matvar_t* aclass = findMatrix(mat, "Aclass");
+		if (aclass == NULL) {
+			return;
+		}
+		if (aclass->class_type != MAT_C_CHAR || aclass->dims[0] < 4) {
+			ModelicaFormatError("Variable \"Aclass\" of file \"%s\" is "
+				"not a valid simulation result file header.\n", mat->fileName);
+			return;
+		}
+		if (NULL == aclass->data) {
+			(void)Mat_VarReadDataAll(mat->mat, aclass);
+		}
+		mat->isTransposed = 0;
+		if (NULL != aclass->data && aclass->dims[1] >= 8) {
+			const char* binTrans = "binTrans";
+			const char* data = (const char*)aclass->data;
+			size_t j;
+			mat->isTransposed = 1;
+			for (j = 0; j < 8; j++) {
+				if (data[3 + j*aclass->dims[0]] != binTrans[j]) {
+					mat->isTransposed = 0;
+					break;
+				}
+			}
+		}
+	}
+
+	name = findMatrix(mat, "name");
+	if (name == NULL) {
+		return;
+	}
+	if (name->class_type != MAT_C_CHAR) {
+		ModelicaFormatError("2D array \"name\" has not the required "
+			"character class.\n");
+		return;
+	}
+	if (NULL == name->data) {
+		(void)Mat_VarReadDataAll(mat->mat, name);
+		if (NULL == name->data) {
+			ModelicaFormatError("Error when reading signal names from file \"%s\"\n",
+				mat->fileName);
+			return;
+		}
+	}
+	nSignals = mat->isTransposed == 1 ? name->dims[1] : name->dims[0];
+	nLen = mat->isTransposed == 1 ? name->dims[0] : name->dims[1];
+
+	dataInfo = findRealMatrix(mat, "dataInfo");
+	if (dataInfo == NULL) {
+		return;
+	}
+	if ((mat->isTransposed == 1 ? dataInfo->dims[1] : dataInfo->dims[0]) != nSignals ||
+		(mat->isTransposed == 1 ? dataInfo->dims[0] : dataInfo->dims[1]) < 2) {
+		ModelicaFormatError("Dimensions of \"name\" and \"dataInfo\" do not "
+			"match in file \"%s\"\n", mat->fileName);
+		return;
+	}
+	info = (mat_int32_t*)malloc(dataInfo->dims[0]*dataInfo->dims[1]*sizeof(mat_int32_t));
+	if (info == NULL) {
+		ModelicaError("Memory allocation error\n");
+		return;
+	}
+	err = readData(mat, dataInfo, MAT_C_INT32, info);
+	if (err != 0) {
+		free(info);
+		ModelicaFormatError("Error when reading numeric data of matrix \"dataInfo\" "
+			"from file \"%s\"\n", mat->fileName);
+		return;
+	}
+
+	for (i = 0; i < nSignals; i++) {
+		char* buf = (char*)malloc((nLen + 1)*sizeof(char));
+		const char* data = (const char*)name->data;
+		size_t len = 0;
+		mat_int32_t j, k;
+		if (buf == NULL) {
+			free(info);
+			ModelicaError("Memory allocation error\n");
+			return;
+		}
+		if (mat->isTransposed == 1) {
+			/* Name is stored contiguously */
+			memcpy(buf, data + i*nLen, nLen);
+			j = info[i*dataInfo->dims[0]];
+			k = info[i*dataInfo->dims[0] + 1];
+		}
+		else {
+			size_t l;
+			for (l = 0; l < nLen; l++) {
+				buf[l] = data[i + l*nSignals];
+			}
+			j = info[i];
+			k = info[i + nSignals];
+		}
+		/* Names are padded by blanks or null characters */
+		while (len < nLen && buf[len] != '\0') {
+			len++;
+		}
+		while (len > 0 && buf[len - 1] == ' ') {
+			len--;
+		}
+		if (len > 0 && k != 0) {
+			/* j = 0: Abscissa (time) shared by all data matrices */
+			addSignal(mat, buf, len, j == 1 ? 1 : 2, (size_t)(k < 0 ? -k : k) - 1, k < 0 ? -1 : 1);
+		}
+		free(buf);
+	}
+	free(info);
+	if (mat->signals == NULL) {
+		ModelicaFormatError("Cannot find any signal in file \"%s\"\n", mat->fileName);
+	}
+}
+
+static SignalShare* findSignal(MATFile* mat, const char* varName, matvar_t** data)
+{
+	SignalShare* signal;
+	buildSignalIndex(mat);
+	HASH_FIND_STR(mat->signals, varName, signal);
+	if (signal == NULL) {
+		ModelicaFormatError("Signal \"%s\" not found in file \"%s\".\n",
+			varName, mat->fileName);
+		return NULL;
+	}
+	*data = findRealMatrix(mat, signal->data == 1 ? "data_1" : "data_2");
+	if (*data == NULL) {
+		return NULL;
+	}
+	if (signal->idx >= (*data)->dims[mat->isTransposed == 1 ? 0 : 1]) {
+		ModelicaFormatError("Signal \"%s\" is out of range of \"data_%d\" "
+			"in file \"%s\".\n", varName, signal->data, mat->fileName);
+		return NULL;
+	}
+	return signal;
+}
+
+static int readSignalByColumns(MATFile* mat, matvar_t* data, size_t idx, double* a, size_t n)
+{
+	/* A row of a transposed data matrix is read by blocks of whole columns,
+	   i.e., sequentially, instead of one value per column. Since the columns
+	   are short, the strided read would load the same file blocks anyway. */
+	const size_t nRows = data->dims[0];
+	const size_t nCols = nRows < READ_BLOCK_LENGTH ? READ_BLOCK_LENGTH/nRows : 1;
+	int start[2] = {0, 0};
+	int stride[2] = {1, 1};
+	int edge[2];
+	size_t j;
+	double* buf = (double*)malloc(nRows*nCols*sizeof(double));
+	if (buf == NULL) {
+		ModelicaError("Memory allocation error\n");
+		return -1;
+	}
+	edge[0] = (int)nRows;
+	for (j = 0; j < n; j += nCols) {
+		const size_t nBlock = n - j < nCols ? n - j : nCols;
+		size_t k;
+		start[1] = (int)j;
+		edge[1] = (int)nBlock;
+		if (readSlab(mat, data, MAT_C_DOUBLE, buf, start, stride, edge) != 0) {
+			free(buf);
+			return -1;
+		}
+		for (k = 0; k < nBlock; k++) {
+			a[j + k] = buf[k*nRows + idx];
+		}
+	}
+	free(buf);
+	return 0;
+}
+
+int ED_getTrajectorySizeFromMAT(void* _mat, const char* varName)
+{
+	int n = 0;
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		matvar_t* data = NULL;
+		if (findSignal(mat, varName, &data) != NULL) {
+			n = (int)data->dims[mat->isTransposed == 1 ? 1 : 0];
+		}
+	}
+	return n;
+}
+
+void ED_getTrajectoryFromMAT(void* _mat, const char* varName, double* a, size_t n)
+{
+	MATFile* mat = (MATFile*)_mat;
+	ED_PTR_CHECK(mat);
+	if (mat != NULL) {
+		matvar_t* data = NULL;
+		const SignalShare* signal = findSignal(mat, varName, &data);
+		if (signal != NULL) {
+			const size_t nPoints = data->dims[mat->isTransposed == 1 ? 1 : 0];
+			enum matio_types mapped_type;
+			const unsigned char* p;
+			int start[2];
+			int stride[2] = {1, 1};
+			int edge[2];
+			int err;
+
+			if (n != nPoints) {
+				ModelicaFormatError(
+					"Cannot read %lu values of trajectory \"%s(%lu)\" "
+					"from file \"%s\"\n", (unsigned long)n, varName,
+					(unsigned long)nPoints, mat->fileName);
+				return;
+			}
+			if (n == 0) {
+				return;
+			}
+
+			p = findMappedData(mat, signal->data == 1 ? "data_1" : "data_2", data, &mapped_type);
+			if (p != NULL) {
+				/* Copy the (strided) signal values from the file mapping */
+				if (mat->isTransposed == 1) {
+					copyMappedData(p, mapped_type, signal->idx, data->dims[0], n, a);
+				}
+				else {
+					copyMappedData(p, mapped_type, signal->idx*data->dims[0], 1, n, a);
+				}
+				err = 0;
+			}
+			else if (mat->isTransposed == 1 &&
+				data->dims[0]*Mat_SizeOf(data->data_type) <= MAX_READ_COLUMN_SIZE) {
+				err = readSignalByColumns(mat, data, signal->idx, a, n);
+			}
+			else {
+				/* Only read the slab of the signal */
+				if (mat->isTransposed == 1) {
+					start[0] = (int)signal->idx;
+					start[1] = 0;
+					edge[0] = 1;
+					edge[1] = (int)n;
+				}
+				else {
+					start[0] = 0;
+					start[1] = (int)signal->idx;
+					edge[0] = (int)n;
+					edge[1] = 1;
+				}
+				err = readSlab(mat, data, MAT_C_DOUBLE, a, start, stride, edge);
+			}
+			if (err != 0) {
+				ModelicaFormatError(
+					"Error when reading trajectory \"%s\" from file \"%s\"\n",
+					varName, mat->fileName);
+				return;
+			}
+			if (signal->sign < 0) {
+				size_t i;
+				for (i = 0; i < n; i++) {
+					a[i] = -a[i];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,978 @@
+/* ED_XLSBFile.c - Excel XLSB functions
+ *
+ * Copyright (C) 2015-2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if defined(__gnu_linux__)
+#define _GNU_SOURCE 1
+#endif
+
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#define strdup _strdup
+#if _MSC_VER < 1900
+#define snprintf _snprintf
+#endif
+#endif
+#include "ED_locale.h"
+#include "ED_logging.h"
+#include "ED_ptrtrack.h"
+#include "ED_workbook.h"
+#include "ModelicaUtilities.h"
+#include "ED_XLSBFile.h"
+
+#define WB_BIN "xl/workbook.bin"
+#define WB_RELS "xl/_rels/workbook.bin.rels"
+#define STR_BIN "xl/sharedStrings.bin"
+
+/* BIFF12 record types, see [MS-XLSB] 2.3.2 */
+#define BRT_ROW_HDR (0)
+#define BRT_CELL_BLANK (1)
+#define BRT_CELL_RK (2)
+#define BRT_CELL_ERROR (3)
+#define BRT_CELL_BOOL (4)
+#define BRT_CELL_REAL (5)
+#define BRT_CELL_ST (6)
+#define BRT_CELL_ISST (7)
+#define BRT_FMLA_STRING (8)
+#define BRT_FMLA_NUM (9)
+#define BRT_FMLA_BOOL (10)
+#define BRT_FMLA_ERROR (11)
+#define BRT_SST_ITEM (19)
+#define BRT_CELL_RSTRING (62)
+#define BRT_BEGIN_BUNDLE_SHS (143)
+#define BRT_END_BUNDLE_SHS (144)
+#define BRT_BEGIN_SHEET_DATA (145)
+#define BRT_END_SHEET_DATA (146)
+#define BRT_WS_DIM (148)
+#define BRT_BUNDLE_SH (156)
+#define BRT_BEGIN_SST (159)
+
+#define CELL_HEADER_SIZE (8) /* Column and style of a cell record */
+
+typedef struct {
+	char* fileName;
+	ED_LOCALE_TYPE loc;
+	ED_LOGGING_FUNC log;
+	unzFile zfile;
+	ZipEntry* entries; /* Central directory by entry name */
+	SharedStrings sst; /* Loaded on first string access */
+	SheetShare* sheets;
+	char* defaultSheetName;
+} XLSBFile;
+
+typedef struct {
+	unzFile zfile;
+	unsigned char* buf; /* Inflated bytes of the entry */
+	size_t len;
+	size_t pos;
+	const unsigned char* data; /* Payload of the current record */
+	DWORD size;
+	unsigned char* record; /* Payload spanning a buffer refill */
+	size_t recordCapacity;
+} RecordStream;
+
+static int openRecordStream(RecordStream* rs, unzFile zfile, ZipEntry* entries, const char* fileName)
+{
+	int rc;
+	memset(rs, 0, sizeof(RecordStream));
+	rc = ED_locateFile(zfile, entries, fileName);
+	if (rc != 0) {
+		return rc;
+	}
+	rs->buf = (unsigned char*)malloc(READ_BUFFER_SIZE);
+	if (rs->buf == NULL) {
+		return E_NO_MEMORY;
+	}
+	if (unzOpenCurrentFile(zfile) != UNZ_OK) {
+		free(rs->buf);
+		rs->buf = NULL;
+		return E_EOPEN;
+	}
+	rs->zfile = zfile;
+	return 0;
+}
+
+static void closeRecordStream(RecordStream* rs)
+{
+	if (rs->zfile != NULL) {
+		unzCloseCurrentFile(rs->zfile);
+	}
+	free(rs->buf);
+	free(rs->record);
+	memset(rs, 0, sizeof(RecordStream));
+}
+
+static int fillBuffer(RecordStream* rs)
+{
+	const int len = unzReadCurrentFile(rs->zfile, rs->buf, READ_BUFFER_SIZE);
+	if (len < 0) {
+		return E_EREAD;
+	}
+	rs->len = (size_t)len;
+	rs->pos = 0;
+	return len > 0 ? 0 : E_END_OF_STREAM;
+}
+
+static int readByte(RecordStream* rs, unsigned char* b)
+{
+	if (rs->pos == rs->len) {
+		int rc = fillBuffer(rs);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+	*b = rs->buf[rs->pos++];
+	return 0;
+}
+
+static int readRecord(RecordStream* rs, DWORD* type)
+{
+	/* Variable length record type and size, 7 bits per byte, see [MS-XLSB] 2.1.4 */
+	unsigned char b;
+	int i;
+	int rc = readByte(rs, &b);
+	if (rc != 0) {
+		/* Regular end of the stream at a record boundary */
+		return rc;
+	}
+	*type = b & 0x7F;
+	if (b & 0x80) {
+		if (0 != (rc = readByte(rs, &b))) {
+			return E_END_OF_STREAM == rc ? E_BAD_DATA : rc;
+		}
+		*type |= (DWORD)(b & 0x7F) << 7;
+	}
+	rs->size = 0;
+	for (i = 0; i < 4; i++) {
+		if (0 != (rc = readByte(rs, &b))) {
+			return E_END_OF_STREAM == rc ? E_BAD_DATA : rc;
+		}
+		rs->size |= (DWORD)(b & 0x7F) << (7*i);
+		if (!(b & 0x80)) {
+			break;
+		}
+	}
+	if (rs->len - rs->pos >= rs->size) {
+		/* Payload within the buffer, no copy */
+		rs->data = rs->buf + rs->pos;
+		rs->pos += rs->size;
+	}
+	else {
+		size_t n = 0;
+		if (rs->size > rs->recordCapacity) {
+			unsigned char* record = (unsigned char*)realloc(rs->record, rs->size);
+			if (record == NULL) {
+				return E_NO_MEMORY;
+			}
+			rs->record = record;
+			rs->recordCapacity = rs->size;
+		}
+		while (n < rs->size) {
+			size_t chunk = rs->len - rs->pos;
+			if (chunk == 0) {
+				if (0 != (rc = fillBuffer(rs))) {
+					return E_END_OF_STREAM == rc ? E_BAD_DATA : rc;
+				}
+				continue;
+			}
+			if (chunk > rs->size - n) {
+				chunk = rs->size - n;
+			}
+			memcpy(rs->record + n, rs->buf + rs->pos, chunk);
+			rs->pos += chunk;
+			n += chunk;
+		}
+		rs->data = rs->record;
+	}
+	return 0;
+}
+
+static DWORD getDWORD(const unsigned char* p)
+{
+	return (DWORD)p[0] | ((DWORD)p[1] << 8) | ((DWORD)p[2] << 16) | ((DWORD)p[3] << 24);
+}
+
+static double getDouble(const unsigned char* p)
+{
+	const uint64_t bits = (uint64_t)getDWORD(p) | ((uint64_t)getDWORD(p + 4) << 32);
+	double val;
+	memcpy(&val, &bits, sizeof(double));
+	return val;
+}
+
+static double getRk(DWORD rk)
+{
+	/* RkNumber, see [MS-XLSB] 2.5.122 */
+	double val;
+	if (rk & 0x02) {
+		val = (double)((int32_t)(rk & 0xFFFFFFFC))/4.;
+	}
+	else {
+		const uint64_t bits = (uint64_t)(rk & 0xFFFFFFFC) << 32;
+		memcpy(&val, &bits, sizeof(double));
+	}
+	if (rk & 0x01) {
+		val /= 100.;
+	}
+	return val;
+}
+
+static size_t getWideStringLength(const unsigned char* p, size_t size, DWORD* cch)
+{
+	/* Number of bytes of a XLWideString or zero if truncated */
+	if (size < 4) {
+		return 0;
+	}
+	*cch = getDWORD(p);
+	if (*cch > (size - 4)/2) {
+		return 0;
+	}
+	return 4 + 2*(size_t)*cch;
+}
+
+static size_t wideToUTF8(const unsigned char* src, DWORD cch, char* dest)
+{
+	/* Convert UTF-16LE to UTF-8, dest must hold 3*cch bytes */
+	size_t len = 0;
+	DWORD i;
+	for (i = 0; i < cch; i++) {
+		DWORD c = (DWORD)src[2*i] | ((DWORD)src[2*i + 1] << 8);
+		if (c >= 0xD800 && c < 0xDC00 && i + 1 < cch) {
+			const DWORD c2 = (DWORD)src[2*i + 2] | ((DWORD)src[2*i + 3] << 8);
+			if (c2 >= 0xDC00 && c2 < 0xE000) {
+				c = 0x10000 + ((c - 0xD800) << 10) + (c2 - 0xDC00);
+				i++;
+			}
+		}
+		if (c < 0x80) {
+			dest[len++] = (char)c;
+		}
+		else if (c < 0x800) {
+			dest[len++] = (char)(0xC0 | (c >> 6));
+			dest[len++] = (char)(0x80 | (c & 0x3F));
+		}
+		else if (c < 0x10000) {
+			dest[len++] = (char)(0xE0 | (c >> 12));
+			dest[len++] = (char)(0x80 | ((c >> 6) & 0x3F));
+			dest[len++] = (char)(0x80 | (c & 0x3F));
+		}
+		else {
+			dest[len++] = (char)(0xF0 | (c >> 18));
+			dest[len++] = (char)(0x80 | ((c >> 12) & 0x3F));
+			dest[len++] = (char)(0x80 | ((c >> 6) & 0x3F));
+			dest[len++] = (char)(0x80 | (c & 0x3F));
+		}
+	}
+	return len;
+}
+
+static char* getWideString(const unsigned char* p, size_t size)
+{
+	/* New UTF-8 string from XLWideString or NULL */
+	DWORD cch = 0;
+	char* str;
+	if (0 == getWideStringLength(p, size, &cch)) {
+		return NULL;
+	}
+	str = (char*)malloc(3*(size_t)cch + 1);
+	if (str != NULL) {
+		str[wideToUTF8(p + 4, cch, str)] = '\0';
+	}
+	return str;
+}
+
+static const char* getErrorString(unsigned char err)
+{
+	/* BErr, see [MS-XLSB] 2.5.97.2 */
+	switch (err) {
+		case 0x00: return "#NULL!";
+		case 0x07: return "#DIV/0!";
+		case 0x0F: return "#VALUE!";
+		case 0x17: return "#REF!";
+		case 0x1D: return "#NAME?";
+		case 0x24: return "#NUM!";
+		case 0x2A: return "#N/A";
+		case 0x2B: return "#GETTING_DATA";
+		default: return "#N/A";
+	}
+}
+
+static int addCell(SheetBuilder* sb, DWORD type, const unsigned char* data, DWORD size)
+{
+	SheetCell* cell;
+	const unsigned char* value = data + CELL_HEADER_SIZE;
+	const size_t valueSize = size - CELL_HEADER_SIZE;
+	const char* error;
+	char* text;
+	DWORD cch = 0;
+	int rc;
+	if (size < CELL_HEADER_SIZE) {
+		return 0;
+	}
+	rc = ED_nextSheetCell(sb, &cell);
+	if (NULL == cell) {
+		return rc;
+	}
+	cell->col = getDWORD(data);
+	switch (type) {
+		case BRT_CELL_RK:
+			if (valueSize < 4) {
+				return 0;
+			}
+			cell->type = CELL_NUMBER;
+			cell->value.number = getRk(getDWORD(value));
+			break;
+
+		case BRT_CELL_REAL:
+		case BRT_FMLA_NUM:
+			if (valueSize < 8) {
+				return 0;
+			}
+			cell->type = CELL_NUMBER;
+			cell->value.number = getDouble(value);
+			break;
+
+		case BRT_CELL_BOOL:
+		case BRT_FMLA_BOOL:
+			if (valueSize < 1) {
+				return 0;
+			}
+			cell->type = CELL_NUMBER;
+			cell->value.number = value[0] ? 1. : 0.;
+			break;
+
+		case BRT_CELL_ISST:
+			if (valueSize < 4) {
+				return 0;
+			}
+			cell->type = CELL_SHARED_STRING;
+			cell->value.sst = (size_t)getDWORD(value);
+			break;
+
+		case BRT_CELL_ERROR:
+		case BRT_FMLA_ERROR:
+			if (valueSize < 1) {
+				return 0;
+			}
+			cell->type = CELL_STRING;
+			error = getErrorString(value[0]);
+			if (NULL == (text = ED_reserveSheetText(sb, strlen(error)))) {
+				return E_NO_MEMORY;
+			}
+			memcpy(text, error, strlen(error));
+			ED_commitSheetText(sb, cell, strlen(error));
+			break;
+
+		case BRT_CELL_RSTRING:
+			/* RichStr: flags followed by the plain text */
+			if (valueSize < 1 || 0 == getWideStringLength(value + 1, valueSize - 1, &cch)) {
+				return 0;
+			}
+			cell->type = CELL_STRING;
+			if (NULL == (text = ED_reserveSheetText(sb, 3*(size_t)cch))) {
+				return E_NO_MEMORY;
+			}
+			ED_commitSheetText(sb, cell, wideToUTF8(value + 5, cch, text));
+			break;
+
+		default: /* BRT_CELL_ST and BRT_FMLA_STRING */
+			if (0 == getWideStringLength(value, valueSize, &cch)) {
+				return 0;
+			}
+			cell->type = CELL_STRING;
+			if (NULL == (text = ED_reserveSheetText(sb, 3*(size_t)cch))) {
+				return E_NO_MEMORY;
+			}
+			ED_commitSheetText(sb, cell, wideToUTF8(value + 4, cch, text));
+			break;
+	}
+	ED_commitSheetCell(sb);
+	return 0;
+}
+
+static int parseSheet(unzFile zfile, ZipEntry* entries, const char* fileName, ED_LOCALE_TYPE loc, Sheet** sheet)
+{
+	RecordStream rs;
+	SheetBuilder sb;
+	DWORD type;
+	int rc;
+	(void)loc;
+	*sheet = NULL;
+	memset(&sb, 0, sizeof(SheetBuilder));
+	sb.sheet = (Sheet*)calloc(1, sizeof(Sheet));
+	if (NULL == sb.sheet) {
+		return E_NO_MEMORY;
+	}
+	rc = openRecordStream(&rs, zfile, entries, fileName);
+	while (0 == rc && 0 == (rc = readRecord(&rs, &type))) {
+		switch (type) {
+			case BRT_ROW_HDR:
+				if (rs.size >= 4) {
+					rc = ED_addSheetRow(&sb, getDWORD(rs.data));
+				}
+				break;
+
+			case BRT_CELL_RK:
+			case BRT_CELL_ERROR:
+			case BRT_CELL_BOOL:
+			case BRT_CELL_REAL:
+			case BRT_CELL_ST:
+			case BRT_CELL_ISST:
+			case BRT_FMLA_STRING:
+			case BRT_FMLA_NUM:
+			case BRT_FMLA_BOOL:
+			case BRT_FMLA_ERROR:
+			case BRT_CELL_RSTRING:
+				rc = addCell(&sb, type, rs.data, rs.size);
+				break;
+
+			case BRT_WS_DIM:
+				if (rs.size >= 16) {
+					/* UncheckedRfX: rwFirst, rwLast, colFirst, colLast */
+					sb.sheet->firstRow = getDWORD(rs.data);
+					sb.sheet->lastRow = getDWORD(rs.data + 4);
+					sb.sheet->firstCol = getDWORD(rs.data + 8);
+					sb.sheet->lastCol = getDWORD(rs.data + 12);
+					sb.sheet->hasDimension = 1;
+				}
+				break;
+
+			case BRT_BEGIN_SHEET_DATA:
+				sb.sheet->hasSheetData = 1;
+				break;
+
+			case BRT_END_SHEET_DATA:
+				/* Nothing of interest after the cell table */
+				rc = E_END_OF_STREAM;
+				break;
+
+			default:
+				break;
+		}
+	}
+	closeRecordStream(&rs);
+	if (E_END_OF_STREAM != rc) {
+		ED_freeSheet(sb.sheet);
+		return rc;
+	}
+
+	ED_indexSheet(sb.sheet);
+	*sheet = sb.sheet;
+	return 0;
+}
+
+static int appendSharedString(SharedStrings* sst, const unsigned char* p, DWORD cch)
+{
+	/* Convert in place at the end of data */
+	const size_t len = 3*(size_t)cch + 1;
+	if (sst->size + len > sst->capacity) {
+		size_t capacity = sst->capacity > 0 ? sst->capacity : 4096;
+		char* data;
+		while (sst->size + len > capacity) {
+			capacity *= 2;
+		}
+		data = (char*)realloc(sst->data, capacity);
+		if (NULL == data) {
+			return E_NO_MEMORY;
+		}
+		sst->data = data;
+		sst->capacity = capacity;
+	}
+	sst->size += wideToUTF8(p, cch, sst->data + sst->size);
+	sst->data[sst->size++] = '\0';
+	return 0;
+}
+
+static int addSharedString(SharedStrings* sst, const unsigned char* data, DWORD size)
+{
+	/* RichStr: flags followed by the plain text, runs are ignored */
+	DWORD cch = 0;
+	if (size < 1 || 0 == getWideStringLength(data + 1, size - 1, &cch)) {
+		cch = 0;
+	}
+	if (sst->count == sst->offsetsCapacity) {
+		size_t capacity = sst->offsetsCapacity > 0 ? 2*sst->offsetsCapacity : 256;
+		size_t* offsets = (size_t*)realloc(sst->offsets, capacity*sizeof(size_t));
+		if (NULL == offsets) {
+			return E_NO_MEMORY;
+		}
+		sst->offsets = offsets;
+		sst->offsetsCapacity = capacity;
+	}
+	sst->offsets[sst->count] = sst->size;
+	if (0 != appendSharedString(sst, data + 5, cch)) {
+		return E_NO_MEMORY;
+	}
+	sst->count++;
+	return 0;
+}
+
+static const SharedStrings* findSharedStrings(void* _xlsb)
+{
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	SharedStrings* sst = &xlsb->sst;
+	if (!sst->loaded) {
+		RecordStream rs;
+		DWORD type;
+		int rc = openRecordStream(&rs, xlsb->zfile, xlsb->entries, STR_BIN);
+		while (0 == rc && 0 == (rc = readRecord(&rs, &type))) {
+			if (BRT_SST_ITEM == type) {
+				rc = addSharedString(sst, rs.data, rs.size);
+			}
+			else if (BRT_BEGIN_SST == type && rs.size >= 8 && 0 == sst->offsetsCapacity) {
+				/* cstTotal, cstUnique */
+				const size_t capacity = (size_t)getDWORD(rs.data + 4);
+				if (capacity > 0) {
+					sst->offsets = (size_t*)malloc(capacity*sizeof(size_t));
+					if (NULL != sst->offsets) {
+						sst->offsetsCapacity = capacity;
+					}
+				}
+			}
+		}
+		closeRecordStream(&rs);
+		if (E_END_OF_STREAM != rc) {
+			ED_freeSharedStrings(sst);
+			if (E_NO_MEMORY == rc) {
+				ModelicaError("Memory allocation error\n");
+				return NULL;
+			}
+			/* No (valid) shared strings table */
+		}
+		sst->loaded = 1;
+	}
+	return sst;
+}
+
+static int addSheet(XLSBFile* xlsb, const RelsParser* rp, const unsigned char* data, DWORD size)
+{
+	/* BrtBundleSh: hsState, iTabID, strRelID, strName */
+	DWORD cch = 0;
+	size_t len;
+	char* sheetId;
+	char* sheetName;
+	SheetShare* iter;
+	if (size < 12) {
+		return 0;
+	}
+	data += 8;
+	size -= 8;
+	if (getDWORD(data) == 0xFFFFFFFF) {
+		/* Sheet without relationship */
+		return 0;
+	}
+	len = getWideStringLength(data, size, &cch);
+	if (len == 0) {
+		return E_BAD_DATA;
+	}
+	sheetId = getWideString(data, size);
+	sheetName = getWideString(data + len, size - len);
+	if (sheetId == NULL || sheetName == NULL) {
+		free(sheetId);
+		free(sheetName);
+		return sheetId == NULL ? E_NO_MEMORY : E_BAD_DATA;
+	}
+	iter = (SheetShare*)malloc(sizeof(SheetShare));
+	if (iter == NULL) {
+		free(sheetId);
+		free(sheetName);
+		return E_NO_MEMORY;
+	}
+	iter->sheetName = sheetName;
+	iter->sheetPath = ED_resolveSheetPath(rp, sheetId);
+	iter->sheet = NULL;
+	iter->rc = 0;
+	free(sheetId);
+	HASH_ADD_KEYPTR(hh, xlsb->sheets, iter->sheetName, strlen(iter->sheetName), iter);
+	if (NULL == iter->hh.tbl) {
+		free(iter->sheetName);
+		free(iter->sheetPath);
+		free(iter);
+		return E_NO_MEMORY;
+	}
+	if (xlsb->defaultSheetName == NULL) {
+		xlsb->defaultSheetName = strdup(iter->sheetName);
+	}
+	return 0;
+}
+
+void* ED_createXLSB(const char* fileName, int verbose, int detectMissingData)
+{
+	return ED_createXLSBPreload(fileName, verbose, detectMissingData, 0, NULL, 0);
+}
+
+void* ED_createXLSBPreload(const char* fileName, int verbose, int detectMissingData, int preload, const char** sheetNames, size_t nSheetNames)
+{
+	int rc;
+	int hasSheets = 0;
+	RelsParser rp;
+	RecordStream rs;
+	DWORD type;
+	XLSBFile* xlsb = (XLSBFile*)malloc(sizeof(XLSBFile));
+	if (xlsb == NULL) {
+		ModelicaError("Memory allocation error\n");
+		return NULL;
+	}
+	xlsb->fileName = strdup(fileName);
+	if (xlsb->fileName == NULL) {
+		free(xlsb);
+		ModelicaError("Memory allocation error\n");
+		return NULL;
+	}
+	xlsb->defaultSheetName = NULL;
+	xlsb->sheets = NULL;
+
+	if (verbose == 1) {
+		/* Print info message, that file is loading */
+		ModelicaFormatMessage("... loading \"%s\"\n", fileName);
+	}
+
+	xlsb->zfile = unzOpen64(fileName);
+	if (xlsb->zfile == NULL) {
+		free(xlsb->fileName);
+		free(xlsb);
+		ModelicaFormatError("Cannot open file \"%s\"\n", fileName);
+		return NULL;
+	}
+	rc = ED_readCentralDirectory(xlsb->zfile, &xlsb->entries);
+	if (rc != 0) {
+		unzClose(xlsb->zfile);
+		free(xlsb->fileName);
+		free(xlsb);
+		if (rc == E_NO_MEMORY) {
+			ModelicaError("Memory allocation error\n");
+		}
+		else {
+			ModelicaFormatError("Cannot read the central directory of file \"%s\"\n", fileName);
+		}
+		return NULL;
+	}
+
+	/* Relationships first, so that sheet paths resolve while registering */
+	rc = ED_parseRels(xlsb->zfile, xlsb->entries, WB_RELS, &rp);
+	if (rc != 0 && rc != E_NO_MEMORY) {
+		/* Sheets without target are reported on access */
+		ED_freeRels(&rp);
+		rc = 0;
+	}
+	if (rc == 0) {
+		rc = openRecordStream(&rs, xlsb->zfile, xlsb->entries, WB_BIN);
+		while (0 == rc && 0 == (rc = readRecord(&rs, &type))) {
+			if (BRT_BUNDLE_SH == type) {
+				rc = addSheet(xlsb, &rp, rs.data, rs.size);
+			}
+			else if (BRT_BEGIN_BUNDLE_SHS == type) {
+				hasSheets = 1;
+			}
+			else if (BRT_END_BUNDLE_SHS == type) {
+				rc = E_END_OF_STREAM;
+			}
+		}
+		closeRecordStream(&rs);
+		if (E_END_OF_STREAM == rc) {
+			rc = 0;
+		}
+	}
+	ED_freeRels(&rp);
+
+	if (rc != 0 || !hasSheets) {
+		unzClose(xlsb->zfile);
+		ED_freeCentralDirectory(&xlsb->entries);
+		ED_freeSheetShares(&xlsb->sheets);
+		if (xlsb->defaultSheetName != NULL) {
+			free(xlsb->defaultSheetName);
+		}
+		free(xlsb->fileName);
+		free(xlsb);
+		switch (rc) {
+			case 0:
+				ModelicaFormatError("Cannot find any sheet in file \"%s\"\n", fileName);
+				break;
+			case E_NO_MEMORY:
+				ModelicaError("Memory allocation error\n");
+				break;
+			case E_ELOCATE:
+				ModelicaFormatError("Cannot locate %s in file \"%s\"\n", WB_BIN, fileName);
+				break;
+			case E_EOPEN:
+				ModelicaFormatError("Cannot open %s in file \"%s\"\n", WB_BIN, fileName);
+				break;
+			case E_EREAD:
+				ModelicaFormatError("Cannot read file %s in file \"%s\"\n", WB_BIN, fileName);
+				break;
+			case E_BAD_DATA:
+				ModelicaFormatError("Cannot parse file %s of file \"%s\"\n", WB_BIN, fileName);
+				break;
+			default:
+				break;
+		}
+		return NULL;
+	}
+
+	memset(&xlsb->sst, 0, sizeof(SharedStrings));
+
+	xlsb->loc = ED_INIT_LOCALE;
+	switch (detectMissingData) {
+		case ED_LOG_NONE:
+			xlsb->log = ED_LogNone;
+			break;
+		case ED_LOG_DEBUG:
+			xlsb->log = ED_LogDebug;
+			break;
+		case ED_LOG_ERROR:
+			xlsb->log = ED_LogError;
+			break;
+		default:
+			xlsb->log = ED_LogWarning;
+			break;
+	}
+	if (preload) {
+		ED_preloadSheets(xlsb->fileName, xlsb->entries, xlsb->sheets, sheetNames, nSheetNames,
+			parseSheet, xlsb->loc, xlsb->log, WB_BIN);
+	}
+	ED_PTR_ADD(xlsb);
+	return xlsb;
+}
+
+void ED_destroyXLSB(void* _xlsb)
+{
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	ED_PTR_CHECK(xlsb);
+	if (xlsb != NULL) {
+		if (xlsb->fileName != NULL) {
+			free(xlsb->fileName);
+		}
+		ED_FREE_LOCALE(xlsb->loc);
+		unzClose(xlsb->zfile);
+		ED_freeSheetShares(&xlsb->sheets);
+		ED_freeSharedStrings(&xlsb->sst);
+		ED_freeCentralDirectory(&xlsb->entries);
+		if (xlsb->defaultSheetName != NULL) {
+			free(xlsb->defaultSheetName);
+		}
+		free(xlsb);
+		ED_PTR_DEL(xlsb);
+	}
+}
+
+static const Sheet* findSheet(XLSBFile* xlsb, char** sheetName)
+{
+	SheetShare* iter;
+
+	if (strlen(*sheetName) == 0) {
+		/* Resolve default sheet name */
+		*sheetName = xlsb->defaultSheetName;
+	}
+
+	HASH_FIND_STR(xlsb->sheets, *sheetName, iter);
+	if (iter == NULL) {
+		xlsb->log("Cannot find sheet name \"%s\" in file \"%s\" of file \"%s\"\n",
+			*sheetName, WB_BIN, xlsb->fileName);
+		return NULL;
+	}
+
+	return ED_loadSheet(xlsb->zfile, xlsb->entries, iter, parseSheet, xlsb->loc, xlsb->fileName);
+}
+
+/* Formats a numeric cell as the shortest text that reads back to the same
+   double. This is not the value as displayed by Excel, which depends on the
+   number format of the cell. */
+static void formatNumber(char* buf, size_t size, double value, ED_LOCALE_TYPE loc)
+{
+	double tmp = 0.;
+	char* sep;
+	snprintf(buf, size, "%.15g", value);
+	if (NULL != (sep = strchr(buf, ','))) {
+		*sep = '.';
+	}
+	if (ED_strtod(buf, loc, &tmp, ED_STRICT) || tmp != value) {
+		snprintf(buf, size, "%.17g", value);
+		if (NULL != (sep = strchr(buf, ','))) {
+			*sep = '.';
+		}
+	}
+}
+
+double ED_getDoubleFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, int* exist)
+{
+	double ret = 0.;
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	ED_PTR_CHECK(xlsb);
+	if (xlsb != NULL) {
+		char* _sheetName = (char*)sheetName;
+		const Sheet* sheet = findSheet(xlsb, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			const SheetCell* cell;
+			const char* token;
+			ED_rc(cellAddress, &row, &col);
+			cell = ED_getSheetCell(sheet, row, col, _sheetName, xlsb->fileName);
+			*exist = 1;
+			if (cell != NULL && cell->type == CELL_NUMBER) {
+				ret = cell->value.number;
+			}
+			else if (NULL != (token = ED_getCellText(sheet, cell, findSharedStrings, xlsb))) {
+				if (ED_strtod((char*)token, xlsb->loc, &ret, ED_STRICT)) {
+					ModelicaFormatError("Cannot read double value \"%s\" from file \"%s\"\n",
+						token, xlsb->fileName);
+				}
+			}
+			else {
+				ED_logMissingCell(sheet, row, col, exist, xlsb->log, _sheetName, xlsb->fileName);
+			}
+		}
+		else {
+			*exist = 0;
+			xlsb->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+				_sheetName, xlsb->fileName);
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return ret;
+}
+
+const char* ED_getStringFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, int* exist)
+{
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	ED_PTR_CHECK(xlsb);
+	if (xlsb != NULL) {
+		char* _sheetName = (char*)sheetName;
+		const Sheet* sheet = findSheet(xlsb, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			const char* token;
+			const SheetCell* cell;
+			char buf[32];
+			ED_rc(cellAddress, &row, &col);
+			cell = ED_getSheetCell(sheet, row, col, _sheetName, xlsb->fileName);
+			if (cell != NULL && cell->type == CELL_NUMBER) {
+				formatNumber(buf, sizeof(buf), cell->value.number, xlsb->loc);
+				token = buf;
+			}
+			else {
+				token = ED_getCellText(sheet, cell, findSharedStrings, xlsb);
+			}
+			*exist = 1;
+			if (token != NULL) {
+				char* ret = ModelicaAllocateString(strlen(token));
+				strcpy(ret, token);
+				return (const char*)ret;
+			}
+			else {
+				ED_logMissingCell(sheet, row, col, exist, xlsb->log, _sheetName, xlsb->fileName);
+			}
+		}
+		else {
+			*exist = 0;
+			xlsb->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+				_sheetName, xlsb->fileName);
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return "";
+}
+
+int ED_getIntFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, int* exist)
+{
+	long ret = 0;
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	ED_PTR_CHECK(xlsb);
+	if (xlsb != NULL) {
+		char* _sheetName = (char*)sheetName;
+		const Sheet* sheet = findSheet(xlsb, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			const SheetCell* cell;
+			const char* token;
+			ED_rc(cellAddress, &row, &col);
+			cell = ED_getSheetCell(sheet, row, col, _sheetName, xlsb->fileName);
+			*exist = 1;
+			if (cell != NULL && cell->type == CELL_NUMBER) {
+				/* Convert the stored double, there is no text to parse */
+				const double value = cell->value.number;
+				if (value != floor(value) || value < (double)INT_MIN || value > (double)INT_MAX) {
+					ModelicaFormatError("Cannot read int value %.17g from file \"%s\"\n",
+						value, xlsb->fileName);
+				}
+				ret = (long)value;
+			}
+			else if (NULL != (token = ED_getCellText(sheet, cell, findSharedStrings, xlsb))) {
+				if (ED_strtol((char*)token, xlsb->loc, &ret, ED_STRICT)) {
+					ModelicaFormatError("Cannot read int value \"%s\" from file \"%s\"\n",
+						token, xlsb->fileName);
+				}
+			}
+			else {
+				ED_logMissingCell(sheet, row, col, exist, xlsb->log, _sheetName, xlsb->fileName);
+			}
+		}
+		else {
+			*exist = 0;
+			xlsb->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+				_sheetName, xlsb->fileName);
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return (int)ret;
+}
+
+void ED_getDoubleArray2DFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, double* a, size_t m, size_t n)
+{
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	ED_PTR_CHECK(xlsb);
+	if (xlsb != NULL) {
+		char* _sheetName = (char*)sheetName;
+		const Sheet* sheet = findSheet(xlsb, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			ED_rc(cellAddress, &row, &col);
+			ED_getDoubleArray2DFromSheet(sheet, row, col, a, m, n, findSharedStrings, xlsb,
+				xlsb->loc, xlsb->log, _sheetName, xlsb->fileName);
+		}
+		else {
+			xlsb->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+				_sheetName, xlsb->fileName);
+		}
+	}
+}
+
+void ED_getArray2DDimensionsFromXLSB(void* _xlsb, const char* sheetName, int* m, int* n)
+{
+	XLSBFile* xlsb = (XLSBFile*)_xlsb;
+	int _m = 0;
+	int _n = 0;
+	if (NULL != m)
+		*m = 0;
+	if (NULL != n)
+		*n = 0;
+	ED_PTR_CHECK(xlsb);
+	if (xlsb != NULL) {
+		char* _sheetName = (char*)sheetName;
+		const Sheet* sheet = findSheet(xlsb, &_sheetName);
+		if (sheet != NULL) {
+			ED_getArray2DDimensionsFromSheet(sheet, &_m, &_n);
+		}
+		else {
+			xlsb->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+				_sheetName, xlsb->fileName);
+		}
+	}
+	if (NULL != m)
+		*m = _m;
+	if (NULL != n)
+		*n = _n;
+}
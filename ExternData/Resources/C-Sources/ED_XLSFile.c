@@ -17,6 +17,7 @@
 #include <ctype.h>
 #include "ED_locale.h"
 #include "ED_logging.h"
+#include "ED_parallel.h"
 #include "ED_ptrtrack.h"
 #include "ModelicaUtilities.h"
 #include "xls.h"
@@ -36,9 +37,122 @@ typedef struct {
 	ED_LOGGING_FUNC log;
 	xlsWorkBook* pWB;
 	SheetShare* sheets;
+	xlsWorkBook** preloadWBs; /* Workbooks referenced by the preloaded sheets */
+	size_t nPreloadWBs;
 } XLSFile;
 
+typedef struct {
+	const char* fileName;
+	const char* encoding;
+	xlsWorkBook** pWBs; /* Separate workbook per worker thread */
+	int* sheetNos;
+	xlsWorkSheet** pWSs;
+} Preload;
+
+static void preloadSheet(void* data, size_t thread, size_t job)
+{
+	Preload* preload = (Preload*)data;
+	xlsWorkSheet* pWS;
+	if (preload->pWBs[thread] == NULL) {
+		preload->pWBs[thread] = xls_open(preload->fileName, preload->encoding);
+		if (preload->pWBs[thread] == NULL) {
+			return;
+		}
+	}
+	pWS = xls_getWorkSheet(preload->pWBs[thread], preload->sheetNos[job]);
+	if (pWS == NULL) {
+		return;
+	}
+	if (xls_parseWorkSheetIndex(pWS) != LIBXLS_OK ||
+		xls_parseWorkSheetRows(pWS, 0, 0xFFFF) != LIBXLS_OK) {
+		/* The sheet is decoded again on access, where failures are reported */
+		xls_close_WS(pWS);
+		return;
+	}
+	preload->pWSs[job] = pWS;
+}
+
+static void preloadSheets(XLSFile* xls, const char* encoding, const char** sheetNames, size_t nSheetNames)
+{
+	/* Decode all or the listed sheets in parallel */
+	Preload preload;
+	size_t nJobs = 0;
+	size_t nThreads;
+	size_t i, j;
+	DWORD k;
+	preload.fileName = xls->fileName;
+	preload.encoding = encoding;
+	preload.sheetNos = (int*)malloc((xls->pWB->sheets.count + 1)*sizeof(int));
+	preload.pWSs = (xlsWorkSheet**)calloc(xls->pWB->sheets.count + 1, sizeof(xlsWorkSheet*));
+	if (preload.sheetNos == NULL || preload.pWSs == NULL) {
+		free(preload.sheetNos);
+		free(preload.pWSs);
+		return;
+	}
+	for (k = 0; k < xls->pWB->sheets.count; k++) {
+		const char* sheetName = (const char*)xls->pWB->sheets.sheet[k].name;
+		int found = nSheetNames == 0;
+		for (i = 0; i < nSheetNames && !found; i++) {
+			found = 0 == strcmp(sheetName, sheetNames[i]);
+		}
+		for (j = 0; j < nJobs && found; j++) {
+			/* Only the first of equally named sheets can be accessed */
+			found = 0 != strcmp(sheetName, (const char*)xls->pWB->sheets.sheet[preload.sheetNos[j]].name);
+		}
+		if (found) {
+			preload.sheetNos[nJobs++] = (int)k;
+		}
+	}
+	for (i = 0; i < nSheetNames; i++) {
+		for (k = 0; k < xls->pWB->sheets.count; k++) {
+			if (0 == strcmp(sheetNames[i], (const char*)xls->pWB->sheets.sheet[k].name)) {
+				break;
+			}
+		}
+		if (k == xls->pWB->sheets.count) {
+			xls->log("Cannot find sheet \"%s\" in file \"%s\"\n",
+				sheetNames[i], xls->fileName);
+		}
+	}
+	nThreads = ED_getNumberOfThreads(nJobs);
+	preload.pWBs = (xlsWorkBook**)calloc(nThreads, sizeof(xlsWorkBook*));
+	if (preload.pWBs != NULL) {
+		ED_parallelFor(preloadSheet, &preload, nJobs, nThreads);
+		for (j = 0; j < nJobs; j++) {
+			SheetShare* iter;
+			if (preload.pWSs[j] == NULL) {
+				continue;
+			}
+			iter = (SheetShare*)malloc(sizeof(SheetShare));
+			if (iter != NULL) {
+				iter->sheetName = strdup((const char*)xls->pWB->sheets.sheet[preload.sheetNos[j]].name);
+				iter->pWS = preload.pWSs[j];
+				if (iter->sheetName != NULL) {
+					HASH_ADD_KEYPTR(hh, xls->sheets, iter->sheetName, strlen(iter->sheetName), iter);
+				}
+				if (iter->sheetName == NULL || NULL == iter->hh.tbl) {
+					free(iter->sheetName);
+					free(iter);
+					iter = NULL;
+				}
+			}
+			if (iter == NULL) {
+				xls_close_WS(preload.pWSs[j]);
+			}
+		}
+		xls->preloadWBs = preload.pWBs;
+		xls->nPreloadWBs = nThreads;
+	}
+	free(preload.sheetNos);
+	free(preload.pWSs);
+}
+
 void* ED_createXLS(const char* fileName, const char* encoding, int verbose, int detectMissingData)
+{
+	return ED_createXLSPreload(fileName, encoding, verbose, detectMissingData, 0, NULL, 0);
+}
+
+void* ED_createXLSPreload(const char* fileName, const char* encoding, int verbose, int detectMissingData, int preload, const char** sheetNames, size_t nSheetNames)
 {
 	XLSFile* xls = (XLSFile*)malloc(sizeof(XLSFile));
 	if (xls == NULL) {
@@ -65,6 +179,8 @@ void* ED_createXLS(const char* fileName, const char* encoding, int verbose, int
 		return NULL;
 	}
 	xls->sheets = NULL;
+	xls->preloadWBs = NULL;
+	xls->nPreloadWBs = 0;
 	xls->loc = ED_INIT_LOCALE;
 	switch (detectMissingData) {
 		case ED_LOG_NONE:
@@ -80,6 +196,9 @@ void* ED_createXLS(const char* fileName, const char* encoding, int verbose, int
 			xls->log = ED_LogWarning;
 			break;
 	}
+	if (preload) {
+		preloadSheets(xls, encoding, sheetNames, nSheetNames);
+	}
 	ED_PTR_ADD(xls);
 	return xls;
 }
@@ -102,14 +221,23 @@ void ED_destroyXLS(void* _xls)
 			free(iter);
 		}
 		xls_close(xls->pWB);
+		if (xls->preloadWBs != NULL) {
+			size_t i;
+			for (i = 0; i < xls->nPreloadWBs; i++) {
+				if (xls->preloadWBs[i] != NULL) {
+					xls_close(xls->preloadWBs[i]);
+				}
+			}
+			free(xls->preloadWBs);
+		}
 		free(xls);
 		ED_PTR_DEL(xls);
 	}
 }	
 
-static void rc1(const char* cellAddress, WORD* row, WORD* col)
+static void rc1(const char* cellAddress, DWORD* row, DWORD* col)
 {
-	WORD i = 0, j;
+	DWORD i = 0, j;
 	while (cellAddress[i++] >= 'A');
 	i--;
 	/* i now points to first character of row address */
@@ -118,10 +246,10 @@ static void rc1(const char* cellAddress, WORD* row, WORD* col)
 		*col *= 26;
 		*col += toupper(cellAddress[j]) - 'A' + 1;
 	}
-	*row = (WORD)atoi(cellAddress + i);
+	*row = (DWORD)strtoul(cellAddress + i, NULL, 10);
 }
 
-static void rc(const char* cellAddress, WORD* row, WORD* col)
+static void rc(const char* cellAddress, DWORD* row, DWORD* col)
 {
 	rc1(cellAddress, row, col);
 	if (*col > 0)
@@ -165,10 +293,10 @@ static xlsWorkSheet* findSheet(XLSFile* xls, char** sheetName)
 				*sheetName, xls->fileName);
 			return NULL;
 		}
-		/* Open and parse the sheet */
+		/* Open the sheet and read its index, the rows are decoded on demand */
 		pWS = xls_getWorkSheet(xls->pWB, sheetNo);
 		if (pWS != NULL) {
-			xls_error_t err = xls_parseWorkSheet(pWS);
+			xls_error_t err = xls_parseWorkSheetIndex(pWS);
 			if (err == LIBXLS_OK) {
 				iter = malloc(sizeof(SheetShare));
 				if (iter != NULL) {
@@ -197,6 +325,33 @@ static xlsWorkSheet* findSheet(XLSFile* xls, char** sheetName)
 	return pWS;
 }
 
+static int parseRows(XLSFile* xls, xlsWorkSheet* pWS, const char* sheetName, DWORD firstRow, DWORD lastRow)
+{
+	/* Decode the row blocks of the sheet that contain the rows */
+	if (firstRow > 0xFFFF) {
+		/* Beyond the BIFF8 row limit, nothing to decode */
+		return 1;
+	}
+	if (lastRow > 0xFFFF) {
+		lastRow = 0xFFFF;
+	}
+	if (xls_parseWorkSheetRows(pWS, (WORD)firstRow, (WORD)lastRow) != LIBXLS_OK) {
+		ModelicaFormatError("Cannot parse rows %u to %u of sheet \"%s\" in file \"%s\"\n",
+			(unsigned int)firstRow, (unsigned int)lastRow, sheetName, xls->fileName);
+		return 0;
+	}
+	return 1;
+}
+
+static xlsCell* findCell(xlsWorkSheet* pWS, DWORD row, DWORD col)
+{
+	if (row > 0xFFFF || col > 0xFFFF) {
+		/* Do not let addresses wrap around to valid cells */
+		return NULL;
+	}
+	return xls_cell(pWS, (WORD)row, (WORD)col);
+}
+
 double ED_getDoubleFromXLS(void* _xls, const char* cellAddress, const char* sheetName, int* exist)
 {
 	double ret = 0.;
@@ -207,11 +362,16 @@ double ED_getDoubleFromXLS(void* _xls, const char* cellAddress, const char* shee
 		xlsWorkSheet* pWS = findSheet(xls, &_sheetName);
 		if (NULL != pWS) {
 			xlsCell* cell;
-			WORD row = 0, col = 0;
+			const char* str;
+			DWORD row = 0, col = 0;
 
 			*exist = 1;
 			rc(cellAddress, &row, &col);
-			cell = xls_cell(pWS, row, col);
+			if (!parseRows(xls, pWS, _sheetName, row, row)) {
+				*exist = 0;
+				return ret;
+			}
+			cell = findCell(pWS, row, col);
 			if (cell != NULL && !cell->isHidden) {
 				/* Get the value of the cell (either numeric or string) */
 				if (cell->id == XLS_RECORD_RK || cell->id == XLS_RECORD_MULRK || cell->id == XLS_RECORD_NUMBER) {
@@ -222,17 +382,18 @@ double ED_getDoubleFromXLS(void* _xls, const char* cellAddress, const char* shee
 						ret = cell->d;
 					}
 					else {
-						if (0 == strcmp((char*)cell->str, "bool")) { /* It is boolean */
+						str = xls_cell_get_str(xls->pWB, cell);
+						if (0 == strcmp(str, "bool")) { /* It is boolean */
 							ret = (int)cell->d ? 1. : 0.;
 						}
-						else if (0 == strcmp((char*)cell->str, "error")) { /* Formula is in error */
+						else if (0 == strcmp(str, "error")) { /* Formula is in error */
 							ModelicaFormatError("Error in formula of cell (%u,%u) in sheet \"%s\" of file \"%s\"\n",
 								(unsigned int)row, (unsigned int)col, _sheetName, xls->fileName);
 						}
 						else { /* Valid formula result */
-							if (ED_strtod((char*)cell->str, xls->loc, &ret, ED_STRICT)) {
+							if (ED_strtod((char*)str, xls->loc, &ret, ED_STRICT)) {
 								ModelicaFormatError("Error in cell (%u,%u) when reading double value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-									(unsigned int)row, (unsigned int)col, cell->str, _sheetName, xls->fileName);
+									(unsigned int)row, (unsigned int)col, str, _sheetName, xls->fileName);
 							}
 						}
 					}
@@ -241,10 +402,10 @@ double ED_getDoubleFromXLS(void* _xls, const char* cellAddress, const char* shee
 					xls->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
 						(unsigned int)row, (unsigned int)col, _sheetName, xls->fileName);
 				}
-				else if (cell->str != NULL) {
-					if (ED_strtod((char*)cell->str, xls->loc, &ret, ED_STRICT)) {
+				else if ((str = xls_cell_get_str(xls->pWB, cell)) != NULL) {
+					if (ED_strtod((char*)str, xls->loc, &ret, ED_STRICT)) {
 						ModelicaFormatError("Error in cell (%u,%u) when reading double value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-							(unsigned int)row, (unsigned int)col, cell->str, _sheetName, xls->fileName);
+							(unsigned int)row, (unsigned int)col, str, _sheetName, xls->fileName);
 					}
 				}
 				else {
@@ -276,19 +437,25 @@ const char* ED_getStringFromXLS(void* _xls, const char* cellAddress, const char*
 		xlsWorkSheet* pWS = findSheet(xls, &_sheetName);
 		if (NULL != pWS) {
 			xlsCell* cell;
-			WORD row = 0, col = 0;
+			const char* str;
+			DWORD row = 0, col = 0;
 
 			*exist = 1;
 			rc(cellAddress, &row, &col);
-			cell = xls_cell(pWS, row, col);
+			if (!parseRows(xls, pWS, _sheetName, row, row)) {
+				*exist = 0;
+				return "";
+			}
+			cell = findCell(pWS, row, col);
 			if (cell != NULL && !cell->isHidden) {
 				/* Get the string value of the cell */
 				if (cell->id == XLS_RECORD_FORMULA) {
 					if (cell->l != 0) { /* It is not a number */
-						if ((0 != strcmp((char*)cell->str, "bool")) && /* It is not boolean and */
-							(0 != strcmp((char*)cell->str, "error"))) { /* formula is not in error */
-							char* ret = ModelicaAllocateString(strlen((char*)cell->str));
-							strcpy(ret, (char*)cell->str);
+						str = xls_cell_get_str(xls->pWB, cell);
+						if ((0 != strcmp(str, "bool")) && /* It is not boolean and */
+							(0 != strcmp(str, "error"))) { /* formula is not in error */
+							char* ret = ModelicaAllocateString(strlen(str));
+							strcpy(ret, str);
 							return (const char*)ret;
 						}
 					}
@@ -297,9 +464,9 @@ const char* ED_getStringFromXLS(void* _xls, const char* cellAddress, const char*
 					xls->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
 						(unsigned int)row, (unsigned int)col, _sheetName, xls->fileName);
 				}
-				else if (cell->str != NULL) {
-					char* ret = ModelicaAllocateString(strlen((char*)cell->str));
-					strcpy(ret, (char*)cell->str);
+				else if ((str = xls_cell_get_str(xls->pWB, cell)) != NULL) {
+					char* ret = ModelicaAllocateString(strlen(str));
+					strcpy(ret, str);
 					return (const char*)ret;
 				}
 				else {
@@ -332,11 +499,16 @@ int ED_getIntFromXLS(void* _xls, const char* cellAddress, const char* sheetName,
 		xlsWorkSheet* pWS = findSheet(xls, &_sheetName);
 		if (NULL != pWS) {
 			xlsCell* cell;
-			WORD row = 0, col = 0;
+			const char* str;
+			DWORD row = 0, col = 0;
 
 			*exist = 1;
 			rc(cellAddress, &row, &col);
-			cell = xls_cell(pWS, row, col);
+			if (!parseRows(xls, pWS, _sheetName, row, row)) {
+				*exist = 0;
+				return (int)ret;
+			}
+			cell = findCell(pWS, row, col);
 			if (cell != NULL && !cell->isHidden) {
 				/* Get the value of the cell (either numeric or string) */
 				if (cell->id == XLS_RECORD_RK || cell->id == XLS_RECORD_MULRK || cell->id == XLS_RECORD_NUMBER) {
@@ -347,17 +519,18 @@ int ED_getIntFromXLS(void* _xls, const char* cellAddress, const char* sheetName,
 						ret = (long)cell->d;
 					}
 					else {
-						if (0 == strcmp((char*)cell->str, "bool")) { /* It is boolean */
+						str = xls_cell_get_str(xls->pWB, cell);
+						if (0 == strcmp(str, "bool")) { /* It is boolean */
 							ret = (long)cell->d ? 1 : 0;
 						}
-						else if (0 == strcmp((char*)cell->str, "error")) { /* Formula is in error */
+						else if (0 == strcmp(str, "error")) { /* Formula is in error */
 							ModelicaFormatError("Error in formula of cell (%u,%u) in sheet \"%s\" of file \"%s\"\n",
 								(unsigned int)row, (unsigned int)col, _sheetName, xls->fileName);
 						}
 						else { /* Valid formula result */
-							if (ED_strtol((char*)cell->str, xls->loc, &ret, ED_STRICT)) {
+							if (ED_strtol((char*)str, xls->loc, &ret, ED_STRICT)) {
 								ModelicaFormatError("Error in cell (%u,%u) when reading int value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-									(unsigned int)row, (unsigned int)col, (char*)cell->str, _sheetName, xls->fileName);
+									(unsigned int)row, (unsigned int)col, str, _sheetName, xls->fileName);
 							}
 						}
 					}
@@ -366,10 +539,10 @@ int ED_getIntFromXLS(void* _xls, const char* cellAddress, const char* sheetName,
 					xls->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
 						(unsigned int)row, (unsigned int)col, _sheetName, xls->fileName);
 				}
-				else if (cell->str != NULL) {
-					if (ED_strtol((char*)cell->str, xls->loc, &ret, ED_STRICT)) {
+				else if ((str = xls_cell_get_str(xls->pWB, cell)) != NULL) {
+					if (ED_strtol((char*)str, xls->loc, &ret, ED_STRICT)) {
 						ModelicaFormatError("Error in cell (%u,%u) when reading int value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-							(unsigned int)row, (unsigned int)col, (char*)cell->str, _sheetName, xls->fileName);
+							(unsigned int)row, (unsigned int)col, str, _sheetName, xls->fileName);
 					}
 				}
 				else {
@@ -400,13 +573,18 @@ void ED_getDoubleArray2DFromXLS(void* _xls, const char* cellAddress, const char*
 		char* _sheetName = (char*)sheetName;
 		xlsWorkSheet* pWS = findSheet(xls, &_sheetName);
 		if (NULL != pWS) {
-			WORD row = 0, col = 0;
-			WORD i, j;
+			DWORD row = 0, col = 0;
+			size_t i, j;
 
 			rc(cellAddress, &row, &col);
+			if (m > 0 && !parseRows(xls, pWS, _sheetName, row,
+				(size_t)row + m - 1 > 0xFFFF ? (DWORD)0xFFFF : (DWORD)(row + m - 1))) {
+				return;
+			}
 			for (i = 0; i < m; i++) {
 				for (j = 0; j < n; j++) {
-					xlsCell* cell = xls_cell(pWS, row + i, col + j);
+					xlsCell* cell = findCell(pWS, (DWORD)(row + i), (DWORD)(col + j));
+					const char* str;
 					if (cell != NULL && !cell->isHidden) {
 						/* Get the value of the cell (either numeric or string) */
 						if (cell->id == XLS_RECORD_RK || cell->id == XLS_RECORD_MULRK || cell->id == XLS_RECORD_NUMBER) {
@@ -417,17 +595,18 @@ void ED_getDoubleArray2DFromXLS(void* _xls, const char* cellAddress, const char*
 								a[i*n + j] = cell->d;
 							}
 							else {
-								if (0 == strcmp((char*)cell->str, "bool")) { /* It is boolean */
+								str = xls_cell_get_str(xls->pWB, cell);
+								if (0 == strcmp(str, "bool")) { /* It is boolean */
 									a[i*n + j] = (int)cell->d ? 1. : 0.;
 								}
-								else if (0 == strcmp((char*)cell->str, "error")) { /* Formula is in error */
+								else if (0 == strcmp(str, "error")) { /* Formula is in error */
 									ModelicaFormatError("Error in formula of cell (%u,%u) in sheet \"%s\" of file \"%s\"\n",
 										(unsigned int)(row + i), (unsigned int)(col + j), _sheetName, xls->fileName);
 								}
 								else { /* Valid formula result */
-									if (ED_strtod((char*)cell->str, xls->loc, &a[i*n + j], ED_STRICT)) {
+									if (ED_strtod((char*)str, xls->loc, &a[i*n + j], ED_STRICT)) {
 										ModelicaFormatError("Error in cell (%u,%u) when reading double value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-											(unsigned int)(row + i), (unsigned int)(col + j), cell->str, _sheetName, xls->fileName);
+											(unsigned int)(row + i), (unsigned int)(col + j), str, _sheetName, xls->fileName);
 									}
 								}
 							}
@@ -437,10 +616,10 @@ void ED_getDoubleArray2DFromXLS(void* _xls, const char* cellAddress, const char*
 							xls->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
 								(unsigned int)(row + i), (unsigned int)(col + j), _sheetName, xls->fileName);
 						}
-						else if (cell->str != NULL) {
-							if (ED_strtod((char*)cell->str, xls->loc, &a[i*n + j], ED_STRICT)) {
+						else if ((str = xls_cell_get_str(xls->pWB, cell)) != NULL) {
+							if (ED_strtod((char*)str, xls->loc, &a[i*n + j], ED_STRICT)) {
 								ModelicaFormatError("Error in cell (%u,%u) when reading double value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-									(unsigned int)(row + i), (unsigned int)(col + j), cell->str, _sheetName, xls->fileName);
+									(unsigned int)(row + i), (unsigned int)(col + j), str, _sheetName, xls->fileName);
 							}
 						}
 						else {
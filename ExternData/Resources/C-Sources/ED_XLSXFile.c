@@ -10,96 +10,474 @@
 #define _GNU_SOURCE 1
 #endif
 
-#include <stdint.h>
 #include <string.h>
 #if defined(_MSC_VER)
 #define strdup _strdup
 #endif
-#include <ctype.h>
 #include "ED_locale.h"
 #include "ED_logging.h"
 #include "ED_ptrtrack.h"
-#include "bsxml.h"
+#include "ED_workbook.h"
 #include "ModelicaUtilities.h"
 #include "ED_XLSXFile.h"
-#include "unzip.h"
-#define HASH_NONFATAL_OOM 1
-#include "uthash.h"
-
-#define E_NO_MEMORY (11)
-#define E_BAD_DATA (12)
-#define E_EOPEN (15)
-#define E_ECLOSE (17)
-#define E_EREAD (18)
-#define E_ELOCATE (30)
-#define E_EGETFILEINFO (31)
 
 #define WB_XML "xl/workbook.xml"
 #define WB_RELS "xl/_rels/workbook.xml.rels"
 #define STR_XML "xl/sharedStrings.xml"
 
-typedef uint16_t WORD;
-
-typedef struct {
-	char* sheetName;
-	char* sheetId;
-	XmlNodeRef root;
-	UT_hash_handle hh; /* Hashable structure */
-} SheetShare;
-
 typedef struct {
 	char* fileName;
 	ED_LOCALE_TYPE loc;
 	ED_LOGGING_FUNC log;
 	unzFile zfile;
-	XmlNodeRef sharedStringsRoot;
+	ZipEntry* entries; /* Central directory by entry name */
+	SharedStrings sst; /* Loaded on first string access */
 	SheetShare* sheets;
 	char* defaultSheetName;
 } XLSXFile;
 
-static int parseXML(unzFile zfile, const char* fileName, XmlNodeRef* root)
+typedef struct {
+	XML_Parser parser;
+	ED_LOCALE_TYPE loc;
+	SheetBuilder sb;
+	DWORD nextRow;
+	DWORD col;
+	DWORD nextCol;
+	unsigned char type;
+	int inCell;
+	int inValue;
+	int inInlineString;
+	int inPhonetic;
+	int inText;
+	int hasValue;
+	char* text;
+	size_t textLen;
+	size_t textCapacity;
+	int rc;
+} SheetParser;
+
+static void stopSheetParser(SheetParser* sp, int rc)
 {
-	unz_file_info info;
-	char* buf;
+	sp->rc = rc;
+	XML_StopParser(sp->parser, XML_FALSE);
+}
+
+static void addCell(SheetParser* sp)
+{
+	SheetCell* cell;
+	char* text;
 	int rc;
-	XmlParser xmlParser;
-	rc = unzLocateFile(zfile, fileName, 1);
-	if (rc != UNZ_OK) {
-		return E_ELOCATE;
+	if (0 == sp->textLen && CELL_STRING != sp->type) {
+		return;
+	}
+	rc = ED_nextSheetCell(&sp->sb, &cell);
+	if (NULL == cell) {
+		if (0 != rc) {
+			stopSheetParser(sp, rc);
+		}
+		return;
+	}
+	cell->col = sp->col;
+	cell->type = sp->type;
+	if (CELL_NUMBER == sp->type) {
+		if (ED_strtod(sp->text, sp->loc, &cell->value.number, ED_STRICT)) {
+			/* Keep the text and let the getters report it */
+			cell->type = CELL_STRING;
+		}
+	}
+	else if (CELL_SHARED_STRING == sp->type) {
+		long idx = 0;
+		if (ED_strtol(sp->text, sp->loc, &idx, ED_STRICT) || idx < 0) {
+			/* Invalid index -> blank cell */
+			return;
+		}
+		cell->value.sst = (size_t)idx;
+	}
+	if (CELL_SHARED_STRING != cell->type) {
+		/* Keep the text as stored in the file */
+		text = ED_reserveSheetText(&sp->sb, sp->textLen);
+		if (NULL == text) {
+			stopSheetParser(sp, E_NO_MEMORY);
+			return;
+		}
+		memcpy(text, sp->text, sp->textLen);
+		ED_commitSheetText(&sp->sb, cell, sp->textLen);
+	}
+	ED_commitSheetCell(&sp->sb);
+}
+
+static void XMLCALL sheetStartElement(void* userData, const XML_Char* name, const XML_Char** atts)
+{
+	SheetParser* sp = (SheetParser*)userData;
+	const char* tag = ED_localName(name);
+	if (sp->inCell) {
+		if (0 == strcmp(tag, "v")) {
+			sp->inValue = 1;
+			sp->textLen = 0;
+			sp->text[0] = '\0';
+		}
+		else if (0 == strcmp(tag, "is")) {
+			sp->inInlineString = 1;
+			sp->textLen = 0;
+			sp->text[0] = '\0';
+		}
+		else if (0 == strcmp(tag, "rPh")) {
+			/* Skip phonetic runs of inline strings */
+			sp->inPhonetic = 1;
+		}
+		else if (0 == strcmp(tag, "t") && sp->inInlineString && !sp->inPhonetic) {
+			sp->inText = 1;
+		}
+	}
+	else if (0 == strcmp(tag, "c")) {
+		const char* r = ED_findAttribute(atts, "r");
+		const char* t = ED_findAttribute(atts, "t");
+		if (NULL != r) {
+			DWORD row = 0;
+			ED_rc(r, &row, &sp->col);
+		}
+		else {
+			sp->col = sp->nextCol;
+		}
+		sp->nextCol = sp->col + 1;
+		if (NULL == t || 0 == strcmp(t, "n") || 0 == strcmp(t, "b")) {
+			sp->type = CELL_NUMBER;
+		}
+		else if (0 == strcmp(t, "s")) {
+			sp->type = CELL_SHARED_STRING;
+		}
+		else {
+			sp->type = CELL_STRING;
+		}
+		sp->inCell = 1;
+		sp->hasValue = 0;
+	}
+	else if (0 == strcmp(tag, "row")) {
+		const char* r = ED_findAttribute(atts, "r");
+		DWORD row = sp->nextRow;
+		if (NULL != r) {
+			row = (DWORD)strtoul(r, NULL, 10);
+			if (row > 0) {
+				row--;
+			}
+		}
+		sp->nextRow = row + 1;
+		sp->nextCol = 0;
+		if (0 != ED_addSheetRow(&sp->sb, row)) {
+			stopSheetParser(sp, E_NO_MEMORY);
+		}
 	}
-	rc = unzOpenCurrentFile(zfile);
-	if (rc != UNZ_OK) {
-		return E_EOPEN;
+	else if (0 == strcmp(tag, "sheetData")) {
+		sp->sb.sheet->hasSheetData = 1;
 	}
-	rc = unzGetCurrentFileInfo(zfile, &info, NULL, 0, NULL, 0, NULL, 0);
-	if (rc != UNZ_OK) {
-		return E_EGETFILEINFO;
+	else if (0 == strcmp(tag, "dimension")) {
+		const char* ref = ED_findAttribute(atts, "ref");
+		if (NULL != ref) {
+			const char* colon = strchr(ref, ':');
+			if (NULL != colon) {
+				Sheet* sheet = sp->sb.sheet;
+				ED_rc(ref, &sheet->firstRow, &sheet->firstCol);
+				ED_rc(++colon, &sheet->lastRow, &sheet->lastCol);
+				sheet->hasDimension = 1;
+			}
+		}
 	}
-	buf = malloc(info.uncompressed_size + 1);
-	if (buf == NULL) {
+}
+
+static void XMLCALL sheetEndElement(void* userData, const XML_Char* name)
+{
+	SheetParser* sp = (SheetParser*)userData;
+	const char* tag;
+	if (!sp->inCell) {
+		return;
+	}
+	tag = ED_localName(name);
+	if (0 == strcmp(tag, "v")) {
+		sp->inValue = 0;
+		sp->hasValue = 1;
+	}
+	else if (0 == strcmp(tag, "t")) {
+		sp->inText = 0;
+	}
+	else if (0 == strcmp(tag, "rPh")) {
+		sp->inPhonetic = 0;
+	}
+	else if (0 == strcmp(tag, "is")) {
+		sp->inInlineString = 0;
+		sp->hasValue = 1;
+		sp->type = CELL_STRING;
+	}
+	else if (0 == strcmp(tag, "c")) {
+		sp->inCell = 0;
+		if (sp->hasValue) {
+			addCell(sp);
+		}
+	}
+}
+
+static void XMLCALL sheetCharacterData(void* userData, const XML_Char* s, int len)
+{
+	SheetParser* sp = (SheetParser*)userData;
+	if (sp->inValue || sp->inText) {
+		if (sp->textLen + len + 1 > sp->textCapacity) {
+			size_t capacity = 2*(sp->textLen + len + 1);
+			char* text = (char*)realloc(sp->text, capacity);
+			if (NULL == text) {
+				stopSheetParser(sp, E_NO_MEMORY);
+				return;
+			}
+			sp->text = text;
+			sp->textCapacity = capacity;
+		}
+		memcpy(sp->text + sp->textLen, s, len);
+		sp->textLen += len;
+		sp->text[sp->textLen] = '\0';
+	}
+}
+
+static int parseSheet(unzFile zfile, ZipEntry* entries, const char* fileName, ED_LOCALE_TYPE loc, Sheet** sheet)
+{
+	SheetParser sp;
+	int rc;
+	*sheet = NULL;
+	memset(&sp, 0, sizeof(SheetParser));
+	sp.loc = loc;
+	sp.sb.sheet = (Sheet*)calloc(1, sizeof(Sheet));
+	sp.textCapacity = 64;
+	sp.text = (char*)malloc(sp.textCapacity);
+	sp.parser = XML_ParserCreate(NULL);
+	if (NULL == sp.sb.sheet || NULL == sp.text || NULL == sp.parser) {
+		free(sp.sb.sheet);
+		free(sp.text);
+		if (NULL != sp.parser) {
+			XML_ParserFree(sp.parser);
+		}
 		return E_NO_MEMORY;
 	}
-	rc = unzReadCurrentFile(zfile, buf, info.uncompressed_size);
-	if (rc < 0) {
-		free(buf);
-		return E_EREAD;
+	sp.text[0] = '\0';
+	XML_SetUserData(sp.parser, &sp);
+	XML_SetElementHandler(sp.parser, sheetStartElement, sheetEndElement);
+	XML_SetCharacterDataHandler(sp.parser, sheetCharacterData);
+	rc = ED_streamXML(zfile, entries, fileName, sp.parser);
+	if (0 != sp.rc) {
+		/* Error raised by a callback */
+		rc = sp.rc;
 	}
-	buf[info.uncompressed_size] = '\0';
-	*root = XmlParser_parse(&xmlParser, buf);
-	free(buf);
-	if (*root == NULL) {
-		return E_BAD_DATA;
+	XML_ParserFree(sp.parser);
+	free(sp.text);
+	if (0 != rc) {
+		ED_freeSheet(sp.sb.sheet);
+		return rc;
 	}
 
+	ED_indexSheet(sp.sb.sheet);
+	*sheet = sp.sb.sheet;
+	return 0;
+}
+
+typedef struct {
+	XML_Parser parser;
+	SharedStrings* sst;
+	int inString;
+	int inPhonetic;
+	int inText;
+	int rc;
+} SharedStringsParser;
+
+static int appendSharedString(SharedStrings* sst, const char* s, size_t len)
+{
+	if (sst->size + len > sst->capacity) {
+		size_t capacity = sst->capacity > 0 ? sst->capacity : 4096;
+		char* data;
+		while (sst->size + len > capacity) {
+			capacity *= 2;
+		}
+		data = (char*)realloc(sst->data, capacity);
+		if (NULL == data) {
+			return E_NO_MEMORY;
+		}
+		sst->data = data;
+		sst->capacity = capacity;
+	}
+	memcpy(sst->data + sst->size, s, len);
+	sst->size += len;
 	return 0;
 }
 
+static void XMLCALL sstStartElement(void* userData, const XML_Char* name, const XML_Char** atts)
+{
+	SharedStringsParser* sp = (SharedStringsParser*)userData;
+	SharedStrings* sst = sp->sst;
+	const char* tag = ED_localName(name);
+	if (sp->inString) {
+		if (0 == strcmp(tag, "t")) {
+			/* Plain text or text of a rich text run */
+			sp->inText = !sp->inPhonetic;
+		}
+		else if (0 == strcmp(tag, "rPh")) {
+			sp->inPhonetic = 1;
+		}
+	}
+	else if (0 == strcmp(tag, "si")) {
+		if (sst->count == sst->offsetsCapacity) {
+			size_t capacity = sst->offsetsCapacity > 0 ? 2*sst->offsetsCapacity : 256;
+			size_t* offsets = (size_t*)realloc(sst->offsets, capacity*sizeof(size_t));
+			if (NULL == offsets) {
+				sp->rc = E_NO_MEMORY;
+				XML_StopParser(sp->parser, XML_FALSE);
+				return;
+			}
+			sst->offsets = offsets;
+			sst->offsetsCapacity = capacity;
+		}
+		sst->offsets[sst->count] = sst->size;
+		sp->inString = 1;
+	}
+	else if (0 == strcmp(tag, "sst") && 0 == sst->offsetsCapacity) {
+		const char* uniqueCount = ED_findAttribute(atts, "uniqueCount");
+		if (NULL != uniqueCount) {
+			const size_t capacity = (size_t)strtoul(uniqueCount, NULL, 10);
+			if (capacity > 0) {
+				sst->offsets = (size_t*)malloc(capacity*sizeof(size_t));
+				if (NULL != sst->offsets) {
+					sst->offsetsCapacity = capacity;
+				}
+			}
+		}
+	}
+}
+
+static void XMLCALL sstEndElement(void* userData, const XML_Char* name)
+{
+	SharedStringsParser* sp = (SharedStringsParser*)userData;
+	const char* tag;
+	if (!sp->inString) {
+		return;
+	}
+	tag = ED_localName(name);
+	if (0 == strcmp(tag, "t")) {
+		sp->inText = 0;
+	}
+	else if (0 == strcmp(tag, "rPh")) {
+		sp->inPhonetic = 0;
+	}
+	else if (0 == strcmp(tag, "si")) {
+		sp->inString = 0;
+		if (0 != appendSharedString(sp->sst, "", 1)) {
+			sp->rc = E_NO_MEMORY;
+			XML_StopParser(sp->parser, XML_FALSE);
+			return;
+		}
+		sp->sst->count++;
+	}
+}
+
+static void XMLCALL sstCharacterData(void* userData, const XML_Char* s, int len)
+{
+	SharedStringsParser* sp = (SharedStringsParser*)userData;
+	if (sp->inText) {
+		if (0 != appendSharedString(sp->sst, s, (size_t)len)) {
+			sp->rc = E_NO_MEMORY;
+			XML_StopParser(sp->parser, XML_FALSE);
+		}
+	}
+}
+
+static const SharedStrings* findSharedStrings(void* _xlsx)
+{
+	XLSXFile* xlsx = (XLSXFile*)_xlsx;
+	SharedStrings* sst = &xlsx->sst;
+	if (!sst->loaded) {
+		SharedStringsParser sp;
+		int rc;
+		memset(&sp, 0, sizeof(SharedStringsParser));
+		sp.sst = sst;
+		sp.parser = XML_ParserCreate(NULL);
+		if (NULL == sp.parser) {
+			ModelicaError("Memory allocation error\n");
+			return NULL;
+		}
+		XML_SetUserData(sp.parser, &sp);
+		XML_SetElementHandler(sp.parser, sstStartElement, sstEndElement);
+		XML_SetCharacterDataHandler(sp.parser, sstCharacterData);
+		rc = ED_streamXML(xlsx->zfile, xlsx->entries, STR_XML, sp.parser);
+		if (0 != sp.rc) {
+			rc = sp.rc;
+		}
+		XML_ParserFree(sp.parser);
+		if (0 != rc) {
+			ED_freeSharedStrings(sst);
+			if (E_NO_MEMORY == rc) {
+				ModelicaError("Memory allocation error\n");
+				return NULL;
+			}
+			/* No (valid) shared strings table */
+		}
+		sst->loaded = 1;
+	}
+	return sst;
+}
+
+typedef struct {
+	XML_Parser parser;
+	XLSXFile* xlsx;
+	const RelsParser* rels;
+	int inSheets;
+	int hasSheets;
+	int rc;
+} WorkbookParser;
+
+static void XMLCALL workbookStartElement(void* userData, const XML_Char* name, const XML_Char** atts)
+{
+	WorkbookParser* wp = (WorkbookParser*)userData;
+	const char* tag = ED_localName(name);
+	if (0 == strcmp(tag, "sheets")) {
+		wp->inSheets = 1;
+		wp->hasSheets = 1;
+	}
+	else if (wp->inSheets && 0 == strcmp(tag, "sheet")) {
+		XLSXFile* xlsx = wp->xlsx;
+		const char* sheetName = ED_findAttribute(atts, "name");
+		const char* sheetId = ED_findAttribute(atts, "id");
+		if (sheetName != NULL && sheetId != NULL) {
+			SheetShare* iter = malloc(sizeof(SheetShare));
+			if (iter != NULL) {
+				iter->sheetName = strdup(sheetName);
+				iter->sheetPath = ED_resolveSheetPath(wp->rels, sheetId);
+				iter->sheet = NULL;
+				iter->rc = 0;
+				HASH_ADD_KEYPTR(hh, xlsx->sheets, iter->sheetName, strlen(iter->sheetName), iter);
+				if (NULL == iter->hh.tbl) {
+					free(iter->sheetName);
+					free(iter->sheetPath);
+					free(iter);
+				}
+				if (xlsx->defaultSheetName == NULL) {
+					xlsx->defaultSheetName = strdup(sheetName);
+				}
+			}
+		}
+	}
+}
+
+static void XMLCALL workbookEndElement(void* userData, const XML_Char* name)
+{
+	WorkbookParser* wp = (WorkbookParser*)userData;
+	if (0 == strcmp(ED_localName(name), "sheets")) {
+		wp->inSheets = 0;
+	}
+}
+
 void* ED_createXLSX(const char* fileName, int verbose, int detectMissingData)
 {
-	size_t i;
+	return ED_createXLSXPreload(fileName, verbose, detectMissingData, 0, NULL, 0);
+}
+
+void* ED_createXLSXPreload(const char* fileName, int verbose, int detectMissingData, int preload, const char** sheetNames, size_t nSheetNames)
+{
 	int rc;
-	XmlNodeRef root;
-	XmlNodeRef sheets;
+	RelsParser rp;
+	WorkbookParser wp;
 	XLSXFile* xlsx = (XLSXFile*)malloc(sizeof(XLSXFile));
 	if (xlsx == NULL) {
 		ModelicaError("Memory allocation error\n");
@@ -112,25 +490,74 @@ void* ED_createXLSX(const char* fileName, int verbose, int detectMissingData)
 		return NULL;
 	}
 	xlsx->defaultSheetName = NULL;
+	xlsx->sheets = NULL;
 
 	if (verbose == 1) {
 		/* Print info message, that file is loading */
 		ModelicaFormatMessage("... loading \"%s\"\n", fileName);
 	}
 
-	xlsx->zfile = unzOpen(fileName);
+	xlsx->zfile = unzOpen64(fileName);
 	if (xlsx->zfile == NULL) {
 		free(xlsx->fileName);
 		free(xlsx);
 		ModelicaFormatError("Cannot open file \"%s\"\n", fileName);
 		return NULL;
 	}
-	rc = parseXML(xlsx->zfile, WB_XML, &root);
+	rc = ED_readCentralDirectory(xlsx->zfile, &xlsx->entries);
 	if (rc != 0) {
 		unzClose(xlsx->zfile);
 		free(xlsx->fileName);
 		free(xlsx);
+		if (rc == E_NO_MEMORY) {
+			ModelicaError("Memory allocation error\n");
+		}
+		else {
+			ModelicaFormatError("Cannot read the central directory of file \"%s\"\n", fileName);
+		}
+		return NULL;
+	}
+
+	/* Relationships first, so that sheet paths resolve while registering */
+	rc = ED_parseRels(xlsx->zfile, xlsx->entries, WB_RELS, &rp);
+	if (rc != 0 && rc != E_NO_MEMORY) {
+		/* Sheets without target are reported on access */
+		ED_freeRels(&rp);
+		rc = 0;
+	}
+	memset(&wp, 0, sizeof(WorkbookParser));
+	if (rc == 0) {
+		wp.parser = XML_ParserCreate(NULL);
+		wp.xlsx = xlsx;
+		wp.rels = &rp;
+		if (wp.parser == NULL) {
+			rc = E_NO_MEMORY;
+		}
+		else {
+			XML_SetUserData(wp.parser, &wp);
+			XML_SetElementHandler(wp.parser, workbookStartElement, workbookEndElement);
+			rc = ED_streamXML(xlsx->zfile, xlsx->entries, WB_XML, wp.parser);
+			if (wp.rc != 0) {
+				rc = wp.rc;
+			}
+			XML_ParserFree(wp.parser);
+		}
+	}
+	ED_freeRels(&rp);
+
+	if (rc != 0 || !wp.hasSheets) {
+		unzClose(xlsx->zfile);
+		ED_freeCentralDirectory(&xlsx->entries);
+		ED_freeSheetShares(&xlsx->sheets);
+		if (xlsx->defaultSheetName != NULL) {
+			free(xlsx->defaultSheetName);
+		}
+		free(xlsx->fileName);
+		free(xlsx);
 		switch (rc) {
+			case 0:
+				ModelicaFormatError("Cannot find any sheet in file \"%s\"\n", fileName);
+				break;
 			case E_NO_MEMORY:
 				ModelicaError("Memory allocation error\n");
 				break;
@@ -140,9 +567,6 @@ void* ED_createXLSX(const char* fileName, int verbose, int detectMissingData)
 			case E_EOPEN:
 				ModelicaFormatError("Cannot open %s in file \"%s\"\n", WB_XML, fileName);
 				break;
-			case E_EGETFILEINFO:
-				ModelicaFormatError("Cannot get file info of %s in file \"%s\"\n", WB_XML, fileName);
-				break;
 			case E_EREAD:
 				ModelicaFormatError("Cannot read file %s in file \"%s\"\n", WB_XML, fileName);
 				break;
@@ -155,45 +579,7 @@ void* ED_createXLSX(const char* fileName, int verbose, int detectMissingData)
 		return NULL;
 	}
 
-	sheets = XmlNode_findChild(root, "sheets");
-	if (sheets == NULL) {
-		unzClose(xlsx->zfile);
-		XmlNode_deleteTree(root);
-		free(xlsx->fileName);
-		free(xlsx);
-		ModelicaFormatError("Cannot find any sheet in file \"%s\"\n", fileName);
-		return NULL;
-	}
-	xlsx->sheets = NULL;
-	for (i = 0; i < XmlNode_getChildCount(sheets); i++) {
-		XmlNodeRef child = XmlNode_getChild(sheets, i);
-		if (XmlNode_isTag(child, "sheet")) {
-			char* sheetName = XmlNode_getAttributeValue(child, "name");
-			char* sheetId = XmlNode_getAttributeValue(child, "r:id");
-			if (sheetName != NULL && sheetId != NULL) {
-				SheetShare* iter = malloc(sizeof(SheetShare));
-				if (iter != NULL) {
-					iter->sheetName = strdup(sheetName);
-					iter->sheetId = strdup(sheetId);
-					iter->root = NULL;
-					HASH_ADD_KEYPTR(hh, xlsx->sheets, iter->sheetName, strlen(iter->sheetName), iter);
-					if (NULL == iter->hh.tbl) {
-						free(iter->sheetName);
-						free(iter->sheetId);
-						free(iter);
-					}
-					if (xlsx->defaultSheetName == NULL) {
-						xlsx->defaultSheetName = strdup(sheetName);
-					}
-				}
-			}
-		}
-	}
-
-	XmlNode_deleteTree(root);
-	if (parseXML(xlsx->zfile, STR_XML, &xlsx->sharedStringsRoot) != 0) {
-		xlsx->sharedStringsRoot = NULL;
-	}
+	memset(&xlsx->sst, 0, sizeof(SharedStrings));
 
 	xlsx->loc = ED_INIT_LOCALE;
 	switch (detectMissingData) {
@@ -210,6 +596,10 @@ void* ED_createXLSX(const char* fileName, int verbose, int detectMissingData)
 			xlsx->log = ED_LogWarning;
 			break;
 	}
+	if (preload) {
+		ED_preloadSheets(xlsx->fileName, xlsx->entries, xlsx->sheets, sheetNames, nSheetNames,
+			parseSheet, xlsx->loc, xlsx->log, WB_XML);
+	}
 	ED_PTR_ADD(xlsx);
 	return xlsx;
 }
@@ -219,21 +609,14 @@ void ED_destroyXLSX(void* _xlsx)
 	XLSXFile* xlsx = (XLSXFile*)_xlsx;
 	ED_PTR_CHECK(xlsx);
 	if (xlsx != NULL) {
-		SheetShare* iter;
-		SheetShare* tmp;
 		if (xlsx->fileName != NULL) {
 			free(xlsx->fileName);
 		}
 		ED_FREE_LOCALE(xlsx->loc);
 		unzClose(xlsx->zfile);
-		HASH_ITER(hh, xlsx->sheets, iter, tmp) {
-			free(iter->sheetName);
-			free(iter->sheetId);
-			XmlNode_deleteTree(iter->root);
-			HASH_DEL(xlsx->sheets, iter);
-			free(iter);
-		}
-		XmlNode_deleteTree(xlsx->sharedStringsRoot);
+		ED_freeSheetShares(&xlsx->sheets);
+		ED_freeSharedStrings(&xlsx->sst);
+		ED_freeCentralDirectory(&xlsx->entries);
 		if (xlsx->defaultSheetName != NULL) {
 			free(xlsx->defaultSheetName);
 		}
@@ -242,43 +625,9 @@ void ED_destroyXLSX(void* _xlsx)
 	}
 }
 
-static void rc1(const char* cellAddress, WORD* row, WORD* col)
-{
-	WORD i = 0, j;
-	while (cellAddress[i++] >= 'A');
-	i--;
-	/* i now points to first character of row address */
-	*col = 0;
-	for (j = 0; j < i; j++) {
-		*col *= 26;
-		*col += toupper(cellAddress[j]) - 'A' + 1;
-	}
-	*row = (WORD)atoi(cellAddress + i);
-}
-
-static void rc(const char* cellAddress, WORD* row, WORD* col)
-{
-	rc1(cellAddress, row, col);
-	if (*col > 0)
-		(*col)--;
-	if (*row > 0)
-		(*row)--;
-}
-
-static void ca(char* colAddress, WORD idx)
-{
-	char c = (idx % 26) + 'A';
-	WORD quotient = idx/26;
-	if (quotient > 0) {
-		ca(colAddress, quotient - 1);
-	}
-	strncat(colAddress, &c, 1);
-}
-
-static XmlNodeRef findSheet(XLSXFile* xlsx, char** sheetName)
+static const Sheet* findSheet(XLSXFile* xlsx, char** sheetName)
 {
 	SheetShare* iter;
-	XmlNodeRef root = NULL;
 
 	if (strlen(*sheetName) == 0) {
 		/* Resolve default sheet name */
@@ -292,135 +641,7 @@ static XmlNodeRef findSheet(XLSXFile* xlsx, char** sheetName)
 		return NULL;
 	}
 
-	if (iter->root != NULL) {
-		root = iter->root;
-	}
-	else {
-		XmlNodeRef workbookRelsRoot;
-		if (parseXML(xlsx->zfile, WB_RELS, &workbookRelsRoot) == 0) {
-			size_t i;
-			for (i = 0; i < XmlNode_getChildCount(workbookRelsRoot); i++) {
-				XmlNodeRef child = XmlNode_getChild(workbookRelsRoot, i);
-				if (XmlNode_isTag(child, "Relationship") && 0 == strcmp(iter->sheetId, XmlNode_getAttributeValue(child, "Id"))) {
-					char* target = XmlNode_getAttributeValue(child, "Target");
-					const char* folderPrefix = "xl/";
-					char* sheetPath = malloc((strlen(folderPrefix) + strlen(target) + 1)*sizeof(char));
-					if (sheetPath == NULL) {
-						ModelicaError("Memory allocation error\n");
-						return NULL;
-					}
-					strcpy(sheetPath, folderPrefix);
-					strcat(sheetPath, target);
-					parseXML(xlsx->zfile, sheetPath, &root);
-					free(sheetPath);
-					iter->root = root;
-					break;
-				}
-			}
-			XmlNode_deleteTree(workbookRelsRoot);
-		}
-	}
-	return root;
-}
-
-static int XmlNode_Rowcomparer(const void* a, const void* b)
-{
-	return strcmp(
-		(XmlNode_getAttribute((XmlNode *)a, "r"))->value,
-		(XmlNode_getAttribute((XmlNode *)b, "r"))->value);
-}
-
-static XmlNodeRef XmlNode_findRow(XmlNodeRef node, const char* row)
-{
-	XmlNodeRef ret;
-	XmlNode tmpNode = {0};
-	tmpNode.m_type = NODE_CHILD;
-	tmpNode.m_attributes = cpo_array_create(1, sizeof(struct XmlAttribute));
-	XmlNode_setAttribute(&tmpNode, "r", row);
-	ret = (XmlNodeRef)cpo_array_bsearch(node->m_childs, &tmpNode, XmlNode_Rowcomparer);
-	XmlNode_delete(&tmpNode);
-	return ret;
-}
-
-static char* findCellValueFromRow(XLSXFile* xlsx, const char* cellAddress, XmlNodeRef root, const char* sheetName)
-{
-	char* token = NULL;
-	XmlNodeRef iter = XmlNode_findRow(root, cellAddress);
-	if (iter != NULL) {
-		XmlNodeRef value = XmlNode_findChild(iter, "v");
-		if (value != NULL) {
-			XmlNode_getValue(value, &token);
-		}
-	}
-	if (token != NULL) {
-		const char* t = XmlNode_getAttributeValue(iter, "t");
-		if (t != NULL && 0 == strncmp(t, "s", 1)) {
-			/* Shared string -> token is the index */
-			long idx = 0;
-			iter = NULL;
-			if (!ED_strtol(token, xlsx->loc, &idx, ED_STRICT)) {
-				if (xlsx->sharedStringsRoot != NULL && (size_t)idx < XmlNode_getChildCount(xlsx->sharedStringsRoot)) {
-					iter = XmlNode_getChild(xlsx->sharedStringsRoot, (int)idx);
-				}
-			}
-			token = NULL;
-			if (iter != NULL) {
-				iter = XmlNode_findChild(iter, "t");
-				if (iter != NULL) {
-					XmlNode_getValue(iter, &token);
-				}
-			}
-		}
-	}
-	return token;
-}
-
-static XmlNodeRef findRow(XLSXFile* xlsx, const char* cellAddress, XmlNodeRef root, const char* sheetName)
-{
-	XmlNodeRef iter = XmlNode_findChild(root, "sheetData");
-	if (iter != NULL) {
-		WORD i = 0;
-		while (cellAddress[i++] >= 'A');
-		iter = XmlNode_findRow(iter, &cellAddress[--i]);
-	}
-	else {
-		ModelicaFormatError("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
-			sheetName, xlsx->fileName);
-	}
-	return iter;
-}
-
-static char* findCellValue(XLSXFile* xlsx, const char* cellAddress, XmlNodeRef root, const char* sheetName)
-{
-	char* token = NULL;
-	XmlNodeRef iter = findRow(xlsx, cellAddress, root, sheetName);
-	if (iter != NULL) {
-		token = findCellValueFromRow(xlsx, cellAddress, iter, sheetName);
-	}
-	return token;
-}
-
-static void findBlankCell(WORD row, WORD col, XmlNodeRef root, int* isBlank)
-{
-	/* Check if blank cell by dimension ref */
-	const XmlNodeRef dim = XmlNode_findChild(root, "dimension");
-	*isBlank = 0;
-	if (NULL != dim) {
-		char* ref = XmlNode_getAttributeValue(dim, "ref");
-		if (NULL != ref) {
-			char* colon = strchr(ref, ':');
-			if (NULL != colon) {
-				WORD refRow = 0, refCol = 0;
-				rc(ref, &refRow, &refCol);
-				if (row >= refRow && col >= refCol) {
-					rc(++colon, &refRow, &refCol);
-					if (row <= refRow && col <= refCol) {
-						*isBlank = 1;
-					}
-				}
-			}
-		}
-	}
+	return ED_loadSheet(xlsx->zfile, xlsx->entries, iter, parseSheet, xlsx->loc, xlsx->fileName);
 }
 
 double ED_getDoubleFromXLSX(void* _xlsx, const char* cellAddress, const char* sheetName, int* exist)
@@ -430,28 +651,25 @@ double ED_getDoubleFromXLSX(void* _xlsx, const char* cellAddress, const char* sh
 	ED_PTR_CHECK(xlsx);
 	if (xlsx != NULL) {
 		char* _sheetName = (char*)sheetName;
-		const XmlNodeRef root = findSheet(xlsx, &_sheetName);
-		if (root != NULL) {
-			char* token = findCellValue(xlsx, cellAddress, root, _sheetName);
+		const Sheet* sheet = findSheet(xlsx, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			const SheetCell* cell;
+			const char* token;
+			ED_rc(cellAddress, &row, &col);
+			cell = ED_getSheetCell(sheet, row, col, _sheetName, xlsx->fileName);
 			*exist = 1;
-			if (token != NULL) {
-				if (ED_strtod(token, xlsx->loc, &ret, ED_STRICT)) {
+			if (cell != NULL && cell->type == CELL_NUMBER) {
+				ret = cell->value.number;
+			}
+			else if (NULL != (token = ED_getCellText(sheet, cell, findSharedStrings, xlsx))) {
+				if (ED_strtod((char*)token, xlsx->loc, &ret, ED_STRICT)) {
 					ModelicaFormatError("Cannot read double value \"%s\" from file \"%s\"\n",
 						token, xlsx->fileName);
 				}
 			}
 			else {
-				WORD row = 0, col = 0;
-				rc(cellAddress, &row, &col);
-				findBlankCell(row, col, root, exist);
-				if (*exist == 1) {
-					xlsx->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-						(unsigned int)row, (unsigned int)col, _sheetName, xlsx->fileName);
-				}
-				else {
-					xlsx->log("Cannot get cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-						(unsigned int)row, (unsigned int)col, _sheetName, xlsx->fileName);
-				}
+				ED_logMissingCell(sheet, row, col, exist, xlsx->log, _sheetName, xlsx->fileName);
 			}
 		}
 		else {
@@ -472,9 +690,13 @@ const char* ED_getStringFromXLSX(void* _xlsx, const char* cellAddress, const cha
 	ED_PTR_CHECK(xlsx);
 	if (xlsx != NULL) {
 		char* _sheetName = (char*)sheetName;
-		const XmlNodeRef root = findSheet(xlsx, &_sheetName);
-		if (root != NULL) {
-			char* token = findCellValue(xlsx, cellAddress, root, _sheetName);
+		const Sheet* sheet = findSheet(xlsx, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			const char* token;
+			ED_rc(cellAddress, &row, &col);
+			token = ED_getCellText(sheet, ED_getSheetCell(sheet, row, col, _sheetName, xlsx->fileName),
+				findSharedStrings, xlsx);
 			*exist = 1;
 			if (token != NULL) {
 				char* ret = ModelicaAllocateString(strlen(token));
@@ -482,17 +704,7 @@ const char* ED_getStringFromXLSX(void* _xlsx, const char* cellAddress, const cha
 				return (const char*)ret;
 			}
 			else {
-				WORD row = 0, col = 0;
-				rc(cellAddress, &row, &col);
-				findBlankCell(row, col, root, exist);
-				if (*exist == 1) {
-					xlsx->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-						(unsigned int)row, (unsigned int)col, _sheetName, xlsx->fileName);
-				}
-				else {
-					xlsx->log("Cannot get cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-						(unsigned int)row, (unsigned int)col, _sheetName, xlsx->fileName);
-				}
+				ED_logMissingCell(sheet, row, col, exist, xlsx->log, _sheetName, xlsx->fileName);
 			}
 		}
 		else {
@@ -514,28 +726,22 @@ int ED_getIntFromXLSX(void* _xlsx, const char* cellAddress, const char* sheetNam
 	ED_PTR_CHECK(xlsx);
 	if (xlsx != NULL) {
 		char* _sheetName = (char*)sheetName;
-		const XmlNodeRef root = findSheet(xlsx, &_sheetName);
-		if (root != NULL) {
-			char* token = findCellValue(xlsx, cellAddress, root, _sheetName);
+		const Sheet* sheet = findSheet(xlsx, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			const SheetCell* cell;
+			const char* token;
+			ED_rc(cellAddress, &row, &col);
+			cell = ED_getSheetCell(sheet, row, col, _sheetName, xlsx->fileName);
 			*exist = 1;
-			if (token != NULL) {
-				if (ED_strtol(token, xlsx->loc, &ret, ED_STRICT)) {
+			if (NULL != (token = ED_getCellText(sheet, cell, findSharedStrings, xlsx))) {
+				if (ED_strtol((char*)token, xlsx->loc, &ret, ED_STRICT)) {
 					ModelicaFormatError("Cannot read int value \"%s\" from file \"%s\"\n",
 						token, xlsx->fileName);
 				}
 			}
 			else {
-				WORD row = 0, col = 0;
-				rc(cellAddress, &row, &col);
-				findBlankCell(row, col, root, exist);
-				if (*exist == 1) {
-					xlsx->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-						(unsigned int)row, (unsigned int)col, _sheetName, xlsx->fileName);
-				}
-				else {
-					xlsx->log("Cannot get cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-						(unsigned int)row, (unsigned int)col, _sheetName, xlsx->fileName);
-				}
+				ED_logMissingCell(sheet, row, col, exist, xlsx->log, _sheetName, xlsx->fileName);
 			}
 		}
 		else {
@@ -556,41 +762,12 @@ void ED_getDoubleArray2DFromXLSX(void* _xlsx, const char* cellAddress, const cha
 	ED_PTR_CHECK(xlsx);
 	if (xlsx != NULL) {
 		char* _sheetName = (char*)sheetName;
-		const XmlNodeRef root = findSheet(xlsx, &_sheetName);
-		if (root != NULL) {
-			WORD row = 0, col = 0;
-			WORD i, j;
-			char cell[63];
-			char tmp[63];
-			rc(cellAddress, &row, &col);
-			for (i = 0; i < m; i++) {
-				for (j = 0; j < n; j++) {
-					char* token;
-					tmp[0] = '\0';
-					ca(tmp, col + j);
-					sprintf(cell, "%s%u", tmp, (unsigned int)(row + i + 1));
-					token = findCellValue(xlsx, cell, root, _sheetName);
-					if (token != NULL) {
-						if (ED_strtod(token, xlsx->loc, &a[i*n + j], ED_STRICT)) {
-							ModelicaFormatError("Error in cell (%u,%u) when reading double value \"%s\" from sheet \"%s\" of file \"%s\"\n",
-								(unsigned int)(row + i), (unsigned int)(col + j), token, _sheetName, xlsx->fileName);
-						}
-					}
-					else {
-						int exist;
-						findBlankCell(row + i, col + j, root, &exist);
-						a[i*n + j] = 0.;
-						if (exist == 1) {
-							xlsx->log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-								(unsigned int)(row +i), (unsigned int)(col + j), _sheetName, xlsx->fileName);
-						}
-						else {
-							xlsx->log("Cannot get cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
-								(unsigned int)(row +i), (unsigned int)(col + j), _sheetName, xlsx->fileName);
-						}
-					}
-				}
-			}
+		const Sheet* sheet = findSheet(xlsx, &_sheetName);
+		if (sheet != NULL) {
+			DWORD row = 0, col = 0;
+			ED_rc(cellAddress, &row, &col);
+			ED_getDoubleArray2DFromSheet(sheet, row, col, a, m, n, findSharedStrings, xlsx,
+				xlsx->loc, xlsx->log, _sheetName, xlsx->fileName);
 		}
 		else {
 			xlsx->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
@@ -611,21 +788,9 @@ void ED_getArray2DDimensionsFromXLSX(void* _xlsx, const char* sheetName, int* m,
 	ED_PTR_CHECK(xlsx);
 	if (xlsx != NULL) {
 		char* _sheetName = (char*)sheetName;
-		const XmlNodeRef root = findSheet(xlsx, &_sheetName);
-		if (root != NULL) {
-			const XmlNodeRef dim = XmlNode_findChild(root, "dimension");
-			if (NULL != dim) {
-				char* ref = XmlNode_getAttributeValue(dim, "ref");
-				if (NULL != ref) {
-					char* colon = strchr(ref, ':');
-					if (NULL != colon) {
-						WORD row = 0, col = 0;
-						rc1(++colon, &row, &col);
-						_m = (int)row;
-						_n = (int)col;
-					}
-				}
-			}
+		const Sheet* sheet = findSheet(xlsx, &_sheetName);
+		if (sheet != NULL) {
+			ED_getArray2DDimensionsFromSheet(sheet, &_m, &_n);
 		}
 		else {
 			xlsx->log("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
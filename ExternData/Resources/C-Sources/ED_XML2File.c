@@ -15,37 +15,56 @@
 #define strdup _strdup
 #endif
 #include "ED_locale.h"
+#include "ED_numlist.h"
 #include "ED_logging.h"
 #include "ED_ptrtrack.h"
 #include <libxml/tree.h>
 #include <libxml/parser.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
+#include <libxml/xmlreader.h>
 #include "ModelicaUtilities.h"
 #include "ED_XML2File.h"
+#define HASH_NONFATAL_OOM 1
+#include "uthash.h"
 
-/* The standard way to detect posix is to check _POSIX_VERSION,
- * which is defined in <unistd.h>
- */
-#if defined(__unix__) || defined(__linux__) || defined(__APPLE_CC__)
-#include <unistd.h>
-#endif
-#if !defined(_POSIX_) && defined(_POSIX_VERSION)
-#define _POSIX_ 1
-#endif
+/* Compiled XPath expression with memoized result */
+typedef struct {
+	char* expr; /* Key */
+	xmlXPathCompExprPtr comp;
+	xmlXPathObjectPtr result;
+	UT_hash_handle hh;
+} XPathExpr;
 
-/* Use re-entrant string tokenize function if available */
-#if defined(_POSIX_)
-#elif defined(_MSC_VER) && _MSC_VER >= 1400
-#define strtok_r(str, delim, saveptr) strtok_s((str), (delim), (saveptr))
-#else
-#define strtok_r(str, delim, saveptr) strtok((str), (delim))
-#endif
+/* Value types of SSV parameters */
+enum {
+	SSV_REAL = 0, /* Real or Float64 */
+	SSV_INTEGER, /* Integer or Int32 */
+	SSV_BOOLEAN,
+	SSV_STRING,
+	SSV_NTYPES
+};
+
+static const char* ssvTypeNames[SSV_NTYPES] = {"Real", "Integer", "Boolean", "String"};
+
+/* SSV parameter with the value and unit attributes of each value type */
+typedef struct SSVParameter {
+	const char* name; /* Key, owned by the document */
+	const char* nameSpace; /* Name space of the Parameters element, owned by the document */
+	xmlAttrPtr value[SSV_NTYPES];
+	xmlAttrPtr unit[SSV_NTYPES]; /* NULL if not available */
+	int count[SSV_NTYPES];
+	struct SSVParameter* next; /* Parameter of same name in another name space */
+	UT_hash_handle hh;
+} SSVParameter;
 
 typedef struct {
 	char* fileName;
 	xmlDocPtr root;
 	xmlXPathContextPtr xpathCtx;
+	XPathExpr* exprs;
+	SSVParameter* ssvParams; /* SSV parameters of all name spaces */
+	double ssvVersion; /* Version of the SSV ParameterSet root element, zero if not available */
 	ED_LOCALE_TYPE loc;
 	ED_LOGGING_FUNC log;
 } XML2File;
@@ -58,7 +77,210 @@ static void errorFunc(void* ctx, const char* string, ...)
 	va_end(args);
 }
 
+/* Stream the XML file and only retain the subtrees (and their ancestors) that
+   match any of the patterns. Text nodes are not size limited. */
+static xmlDocPtr readXML2Pruned(const char* fileName, const char** ns, size_t sizeNS,
+	const char** patterns, size_t sizePatterns, const char** invalidPattern)
+{
+	size_t i;
+	int ret;
+	xmlDocPtr doc = NULL;
+	const xmlChar** nsTab;
+	xmlTextReaderPtr reader = xmlReaderForFile(fileName, NULL, XML_PARSE_HUGE);
+	if (NULL == reader) {
+		return NULL;
+	}
+
+	/* Patterns take the name spaces as [URI, prefix, ..., NULL] */
+	nsTab = (const xmlChar**)malloc((2*sizeNS + 1)*sizeof(xmlChar*));
+	if (NULL == nsTab) {
+		xmlFreeTextReader(reader);
+		return NULL;
+	}
+	for (i = 0; i < sizeNS; i++) {
+		nsTab[2*i] = (const xmlChar*)ns[2*i + 1];
+		nsTab[2*i + 1] = (const xmlChar*)ns[2*i];
+	}
+	nsTab[2*sizeNS] = NULL;
+	for (i = 0; i < sizePatterns; i++) {
+		if (xmlTextReaderPreservePattern(reader, (const xmlChar*)patterns[i], nsTab) < 0) {
+			*invalidPattern = patterns[i];
+			free((void*)nsTab);
+			xmlFreeTextReader(reader);
+			return NULL;
+		}
+	}
+	free((void*)nsTab);
+
+	do {
+		ret = xmlTextReaderRead(reader);
+	} while (1 == ret);
+	if (0 == ret) {
+		doc = xmlTextReaderCurrentDoc(reader);
+	}
+	xmlFreeTextReader(reader);
+	return doc;
+}
+
+/* Text of attribute attr, NULL if not available */
+static const char* getAttrText(xmlAttrPtr attr)
+{
+	if (NULL == attr) {
+		return NULL;
+	}
+	else if (NULL == attr->children) {
+		return "";
+	}
+	else if (attr->children->type == XML_TEXT_NODE && NULL == attr->children->next) {
+		return (const char*)attr->children->content;
+	}
+	return NULL;
+}
+
+/* Version of the SSV ParameterSet root element, independent of its name space */
+static void readSSVVersion(XML2File* xml)
+{
+	xmlNodePtr root = xmlDocGetRootElement(xml->root);
+	if (NULL != root && 0 == strcmp((const char*)root->name, "ParameterSet")) {
+		const char* version = getAttrText(xmlHasProp(root, (const xmlChar*)"version"));
+		if (NULL != version && ED_strtod((char*)version, xml->loc, &xml->ssvVersion, ED_STRICT)) {
+			xml->ssvVersion = 0.;
+		}
+	}
+}
+
+static int isSSVElement(xmlNodePtr node, const char* name, const char* nameSpace)
+{
+	if (node->type != XML_ELEMENT_NODE || 0 != strcmp((const char*)node->name, name)) {
+		return 0;
+	}
+	if ('\0' == *nameSpace) {
+		return NULL == node->ns;
+	}
+	return NULL != node->ns && NULL != node->ns->href &&
+		0 == strcmp((const char*)node->ns->href, nameSpace);
+}
+
+static int getSSVType(xmlNodePtr node, const char* nameSpace)
+{
+	if (isSSVElement(node, "Real", nameSpace) || isSSVElement(node, "Float64", nameSpace)) {
+		return SSV_REAL;
+	}
+	else if (isSSVElement(node, "Integer", nameSpace) || isSSVElement(node, "Int32", nameSpace)) {
+		return SSV_INTEGER;
+	}
+	else if (isSSVElement(node, "Boolean", nameSpace)) {
+		return SSV_BOOLEAN;
+	}
+	else if (isSSVElement(node, "String", nameSpace)) {
+		return SSV_STRING;
+	}
+	return -1;
+}
+
+/* Parameter varName of the SSV name space, NULL if not available */
+static SSVParameter* findSSVParameter(XML2File* xml, const char* varName, const char* nameSpace)
+{
+	SSVParameter* entry = NULL;
+	HASH_FIND_STR(xml->ssvParams, varName, entry);
+	while (NULL != entry && 0 != strcmp(entry->nameSpace, nameSpace)) {
+		entry = entry->next;
+	}
+	return entry;
+}
+
+/* Index the parameters of all Parameters elements below node in document
+   order. Parameters, Parameter and the value type elements share the name
+   space, by which the parameters are told apart. */
+static int indexSSVParameters(XML2File* xml, xmlNodePtr node)
+{
+	for (; NULL != node; node = node->next) {
+		if (node->type != XML_ELEMENT_NODE) {
+			continue;
+		}
+		if (0 == strcmp((const char*)node->name, "Parameters")) {
+			const char* nameSpace = NULL != node->ns && NULL != node->ns->href ?
+				(const char*)node->ns->href : "";
+			xmlNodePtr param;
+			for (param = node->children; NULL != param; param = param->next) {
+				const char* name;
+				xmlNodePtr child;
+				SSVParameter* entry = NULL;
+				if (!isSSVElement(param, "Parameter", nameSpace)) {
+					continue;
+				}
+				name = getAttrText(xmlHasProp(param, (const xmlChar*)"name"));
+				if (NULL == name) {
+					continue;
+				}
+				for (child = param->children; NULL != child; child = child->next) {
+					int type = getSSVType(child, nameSpace);
+					xmlAttrPtr value;
+					if (type < 0) {
+						continue;
+					}
+					value = xmlHasProp(child, (const xmlChar*)"value");
+					if (NULL == value) {
+						continue;
+					}
+					if (NULL == entry) {
+						entry = findSSVParameter(xml, name, nameSpace);
+					}
+					if (NULL == entry) {
+						SSVParameter* head = NULL;
+						entry = (SSVParameter*)calloc(1, sizeof(SSVParameter));
+						if (NULL == entry) {
+							return ED_OOM;
+						}
+						entry->name = name;
+						entry->nameSpace = nameSpace;
+						HASH_FIND_STR(xml->ssvParams, name, head);
+						if (NULL != head) {
+							entry->next = head->next;
+							head->next = entry;
+						}
+						else {
+							HASH_ADD_KEYPTR(hh, xml->ssvParams, entry->name, strlen(entry->name), entry);
+							if (NULL == entry->hh.tbl) {
+								free(entry);
+								return ED_OOM;
+							}
+						}
+					}
+					if (0 == entry->count[type]++) {
+						entry->value[type] = value;
+						entry->unit[type] = xmlHasProp(child, (const xmlChar*)"unit");
+					}
+				}
+			}
+		}
+		if (ED_OK != indexSSVParameters(xml, node->children)) {
+			return ED_OOM;
+		}
+	}
+	return ED_OK;
+}
+
+static void freeSSVIndex(XML2File* xml)
+{
+	SSVParameter* iter;
+	SSVParameter* tmp;
+	HASH_ITER(hh, xml->ssvParams, iter, tmp) {
+		HASH_DEL(xml->ssvParams, iter);
+		while (NULL != iter) {
+			SSVParameter* next = iter->next;
+			free(iter);
+			iter = next;
+		}
+	}
+}
+
 void* ED_createXML2(const char* fileName, const char** ns, size_t sizeNS, int verbose, int detectMissingData)
+{
+	return ED_createXML2Streaming(fileName, ns, sizeNS, NULL, 0, verbose, detectMissingData);
+}
+
+void* ED_createXML2Streaming(const char* fileName, const char** ns, size_t sizeNS, const char** patterns, size_t sizePatterns, int verbose, int detectMissingData)
 {
 	size_t i;
 	XML2File* xml = (XML2File*)malloc(sizeof(XML2File));
@@ -84,7 +306,20 @@ void* ED_createXML2(const char* fileName, const char** ns, size_t sizeNS, int ve
 	}
 
 	/* Load XML document */
-	xml->root = xmlReadFile(fileName, NULL, 0);
+	if (sizePatterns > 0) {
+		const char* invalidPattern = NULL;
+		xml->root = readXML2Pruned(fileName, ns, sizeNS, patterns, sizePatterns, &invalidPattern);
+		if (NULL != invalidPattern) {
+			free(xml->fileName);
+			free(xml);
+			xmlCleanupParser();
+			ModelicaFormatError("Error: Invalid pattern \"%s\" for file \"%s\"\n", invalidPattern, fileName);
+			return NULL;
+		}
+	}
+	else {
+		xml->root = xmlReadFile(fileName, NULL, 0);
+	}
 	if (xml->root == NULL) {
 		free(xml->fileName);
 		free(xml);
@@ -119,7 +354,25 @@ void* ED_createXML2(const char* fileName, const char** ns, size_t sizeNS, int ve
 		}
 	}
 
+	xml->exprs = NULL;
+	xml->ssvParams = NULL;
+	xml->ssvVersion = 0.;
 	xml->loc = ED_INIT_LOCALE;
+	readSSVVersion(xml);
+
+	/* Walk the document once and build the SSV parameter index of all name
+	   spaces, since the name space is only known on access */
+	if (ED_OK != indexSSVParameters(xml, xmlDocGetRootElement(xml->root))) {
+		freeSSVIndex(xml);
+		ED_FREE_LOCALE(xml->loc);
+		xmlXPathFreeContext(xml->xpathCtx);
+		xmlFreeDoc(xml->root);
+		free(xml->fileName);
+		free(xml);
+		xmlCleanupParser();
+		ModelicaError("Memory allocation error\n");
+		return NULL;
+	}
 	switch (detectMissingData) {
 		case ED_LOG_NONE:
 			xml->log = ED_LogNone;
@@ -143,6 +396,16 @@ void ED_destroyXML2(void* _xml)
 	XML2File* xml = (XML2File*)_xml;
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
+		XPathExpr* iter;
+		XPathExpr* tmp;
+		HASH_ITER(hh, xml->exprs, iter, tmp) {
+			HASH_DEL(xml->exprs, iter);
+			xmlXPathFreeCompExpr(iter->comp);
+			xmlXPathFreeObject(iter->result);
+			free(iter->expr);
+			free(iter);
+		}
+		freeSSVIndex(xml);
 		xmlXPathFreeContext(xml->xpathCtx);
 		xmlFreeDoc(xml->root);
 		if (xml->fileName != NULL) {
@@ -157,6 +420,56 @@ void ED_destroyXML2(void* _xml)
 	xmlCleanupParser();
 }
 
+static XPathExpr* addXPathExpr(XML2File* xml, const char* varName, xmlXPathCompExprPtr comp)
+{
+	XPathExpr* expr = (XPathExpr*)malloc(sizeof(XPathExpr));
+	if (NULL == expr) {
+		return NULL;
+	}
+	expr->expr = strdup(varName);
+	if (NULL == expr->expr) {
+		free(expr);
+		return NULL;
+	}
+	expr->comp = comp;
+	expr->result = NULL;
+	HASH_ADD_KEYPTR(hh, xml->exprs, expr->expr, strlen(expr->expr), expr);
+	if (NULL == expr->hh.tbl) {
+		free(expr->expr);
+		free(expr);
+		return NULL;
+	}
+	return expr;
+}
+
+/* The document is never modified, hence each XPath expression is compiled and
+   evaluated once. The caller gets a copy of the result that it needs to free. */
+static xmlXPathObjectPtr evalXPath(XML2File* xml, const char* varName)
+{
+	XPathExpr* expr = NULL;
+	HASH_FIND_STR(xml->exprs, varName, expr);
+	if (NULL == expr) {
+		xmlXPathCompExprPtr comp = xmlXPathCtxtCompile(xml->xpathCtx, (const xmlChar*)varName);
+		if (NULL == comp) {
+			return NULL;
+		}
+		expr = addXPathExpr(xml, varName, comp);
+		if (NULL == expr) {
+			/* Out of memory for the cache: evaluate uncached */
+			xmlXPathObjectPtr xpathObj = xmlXPathCompiledEval(comp, xml->xpathCtx);
+			xmlXPathFreeCompExpr(comp);
+			return xpathObj;
+		}
+	}
+	if (NULL == expr->result) {
+		expr->result = xmlXPathCompiledEval(expr->comp, xml->xpathCtx);
+		if (NULL == expr->result) {
+			return NULL;
+		}
+	}
+	return xmlXPathObjectCopy(expr->result);
+}
+
 double ED_getDoubleFromXML2(void* _xml, const char* varName, int* exist)
 {
 	double ret = 0.;
@@ -164,7 +477,7 @@ double ED_getDoubleFromXML2(void* _xml, const char* varName, int* exist)
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
 		/* Evaluate XPath expression */
-		xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression((const xmlChar*)varName, xml->xpathCtx);
+		xmlXPathObjectPtr xpathObj = evalXPath(xml, varName);
 		*exist = 1;
 		if (xpathObj == NULL) {
 			ModelicaFormatError("Error: Unable to evaluate XPath expression \"%s\" from file \"%s\"\n",
@@ -182,12 +495,10 @@ double ED_getDoubleFromXML2(void* _xml, const char* varName, int* exist)
 				if (token != NULL) {
 					if (ED_strtod(token, xml->loc, &ret, ED_STRICT)) {
 						int line = (int)cur->line;
-						char buf[128];
-						memset(buf, 0, 128);
-						strncpy(buf, token, 127);
+						/* The text is owned by the document, not by the XPath result */
 						xmlXPathFreeObject(xpathObj);
 						ModelicaFormatError("Error in line %i: Cannot read double value \"%s\" from file \"%s\"\n",
-							line, buf, xml->fileName);
+							line, token, xml->fileName);
 					}
 					else {
 						xmlXPathFreeObject(xpathObj);
@@ -237,7 +548,7 @@ const char* ED_getStringFromXML2(void* _xml, const char* varName, int* exist)
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
 		/* Evaluate XPath expression */
-		xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression((const xmlChar*)varName, xml->xpathCtx);
+		xmlXPathObjectPtr xpathObj = evalXPath(xml, varName);
 		*exist = 1;
 		if (xpathObj == NULL) {
 			ModelicaFormatError("Error: Unable to evaluate XPath expression \"%s\" from file \"%s\"\n",
@@ -309,7 +620,7 @@ int ED_getIntFromXML2(void* _xml, const char* varName, int* exist)
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
 		/* Evaluate XPath expression */
-		xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression((const xmlChar*)varName, xml->xpathCtx);
+		xmlXPathObjectPtr xpathObj = evalXPath(xml, varName);
 		*exist = 1;
 		if (xpathObj == NULL) {
 			ModelicaFormatError("Error: Unable to evaluate XPath expression \"%s\" from file \"%s\"\n",
@@ -327,12 +638,10 @@ int ED_getIntFromXML2(void* _xml, const char* varName, int* exist)
 				if (token != NULL) {
 					if (ED_strtol(token, xml->loc, &ret, ED_STRICT)) {
 						int line = (int)cur->line;
-						char buf[128];
-						memset(buf, 0, 128);
-						strncpy(buf, token, 127);
+						/* The text is owned by the document, not by the XPath result */
 						xmlXPathFreeObject(xpathObj);
 						ModelicaFormatError("Error in line %i: Cannot read int value \"%s\" from file \"%s\"\n",
-							line, buf, xml->fileName);
+							line, token, xml->fileName);
 					}
 					else {
 						xmlXPathFreeObject(xpathObj);
@@ -382,7 +691,7 @@ void ED_getDoubleArray1DFromXML2(void* _xml, const char* varName, double* a, siz
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
 		/* Evaluate XPath expression */
-		xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression((const xmlChar*)varName, xml->xpathCtx);
+		xmlXPathObjectPtr xpathObj = evalXPath(xml, varName);
 		if (xpathObj == NULL) {
 			ModelicaFormatError("Error: Unable to evaluate XPath expression \"%s\" from file \"%s\"\n",
 				varName, xml->fileName);
@@ -398,37 +707,25 @@ void ED_getDoubleArray1DFromXML2(void* _xml, const char* varName, double* a, siz
 					type = cur->type;
 				}
 				if (type == XML_TEXT_NODE) {
-					char* token = (char*)cur->content;
+					const char* token = (const char*)cur->content;
 					if (token != NULL) {
-						char* tokenCopy = strdup(token);
-						if (tokenCopy != NULL) {
-							char* nextToken = NULL;
-							token = strtok_r(tokenCopy, "[]{},; \t", &nextToken);
-							while (i < n) {
-								if (token != NULL) {
-									if (ED_strtod(token, xml->loc, &a[i++], ED_STRICT)) {
-										int line = (int)cur->line;
-										char buf[128];
-										memset(buf, 0, 128);
-										strncpy(buf, token, 127);
-										xmlXPathFreeObject(xpathObj);
-										free(tokenCopy);
-										ModelicaFormatError("Error in line %i: Cannot read double value \"%s\" from file \"%s\"\n",
-											line, token, xml->fileName);
-										return;
-									}
-									token = strtok_r(NULL, "[]{},; \t", &nextToken);
-								}
-								else {
-									break;
-								}
-							}
-							free(tokenCopy);
-						}
-						else {
+						size_t nRead;
+						NumListError err;
+						int ret = ED_strtodNumList(token, token + strlen(token), xml->loc, a + i, n - i, &nRead, &err);
+						if (ED_OOM == ret) {
 							xmlXPathFreeObject(xpathObj);
 							ModelicaError("Memory allocation error\n");
+							return;
 						}
+						else if (ED_OK != ret) {
+							int line = (int)cur->line + err.line;
+							/* The text is owned by the document, not by the XPath result */
+							xmlXPathFreeObject(xpathObj);
+							ModelicaFormatError("Error in line %i, position %lu: Cannot read double value \"%.*s\" from file \"%s\"\n",
+								line, (unsigned long)err.pos, (int)err.len, err.token, xml->fileName);
+							return;
+						}
+						i += nRead;
 					}
 					else {
 						int line = (int)cur->line;
@@ -444,7 +741,7 @@ void ED_getDoubleArray1DFromXML2(void* _xml, const char* varName, double* a, siz
 						line, varName, xml->fileName);
 				}
 			}
-			if (i + 1 < n) {
+			if (i < n) {
 				xmlNodePtr cur = xpathObj->nodesetval->nodeTab[xpathObj->nodesetval->nodeNr - 1];
 				int line = (int)cur->line;
 				xmlXPathFreeObject(xpathObj);
@@ -489,7 +786,7 @@ void ED_getArray2DDimensionsFromXML2(void* _xml, const char* varName, int* m, in
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
 		/* Evaluate XPath expression */
-		xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression((const xmlChar*)varName, xml->xpathCtx);
+		xmlXPathObjectPtr xpathObj = evalXPath(xml, varName);
 		if (xpathObj == NULL) {
 			ModelicaFormatError("Error: Unable to evaluate XPath expression \"%s\" from file \"%s\"\n",
 				varName, xml->fileName);
@@ -502,47 +799,39 @@ void ED_getArray2DDimensionsFromXML2(void* _xml, const char* varName, int* m, in
 				type = cur->type;
 			}
 			if (type == XML_TEXT_NODE) {
-				char* token = (char*)cur->content;
+				const char* token = (const char*)cur->content;
 				if (token != NULL) {
-					char* tokenCopy = strdup(token);
-					if (tokenCopy != NULL) {
-						char* nextToken = NULL;
-						char* sep = strchr(tokenCopy, ';');
-						_m = 1;
-						if (NULL != sep) {
-							do {
+					const char* sep = strchr(token, ';');
+					_m = 1;
+					if (NULL != sep) {
+						do {
+							_m++;
+							sep = strchr(sep + 1, ';');
+						} while (NULL != sep);
+					}
+					else {
+						sep = strchr(token, '}');
+						while (NULL != sep) {
+							sep = strchr(sep + 1, ',');
+							if (NULL != sep) {
 								_m++;
-								sep = strchr(sep + 1, ';');
-							} while (NULL != sep);
-						}
-						else {
-							sep = strchr(tokenCopy, '}');
-							while (NULL != sep) {
-								sep = strchr(sep + 1, ',');
-								if (NULL != sep) {
-									_m++;
-									sep = strchr(sep + 1, '}');
-								}
+								sep = strchr(sep + 1, '}');
 							}
 						}
-						token = strtok_r(tokenCopy, "[]{},; \t", &nextToken);
-						if (NULL != token) {
-							do {
-								_n++;
-								token = strtok_r(NULL, "[]{},; \t", &nextToken);
-							} while (NULL != token);
-							if (0 == _n%_m) {
-								_n /= _m;
-							}
-							else {
-								_m = 1;
-							}
+					}
+					_n = (int)ED_countNumList(token, token + strlen(token));
+					if (0 != _n) {
+						if (0 == _n%_m) {
+							_n /= _m;
+						}
+						else {
+							_m = 1;
 						}
-						_m *= xpathObj->nodesetval->nodeNr;
-						free(tokenCopy);
 					}
+					_m *= xpathObj->nodesetval->nodeNr;
 				}
 			}
+			xmlXPathFreeObject(xpathObj);
 		}
 		else if (xpathObj->nodesetval == NULL || xpathObj->nodesetval->nodeNr == 0) {
 			xmlXPathFreeObject(xpathObj);
@@ -558,3 +847,233 @@ void ED_getArray2DDimensionsFromXML2(void* _xml, const char* varName, int* m, in
 	if (NULL != n)
 		*n = _n;
 }
+
+/* Text of the value attribute of SSV parameter varName of given type and,
+   if unit is not NULL, its unit attribute */
+static const char* findSSVValue(XML2File* xml, const char* varName, const char* nameSpace, int type, int* line, int* exist, xmlAttrPtr* unit)
+{
+	const char* token;
+	SSVParameter* entry = findSSVParameter(xml, varName, nameSpace);
+	*exist = 0;
+	*line = 0;
+	if (NULL == entry || 0 == entry->count[type]) {
+		xml->log("Cannot find %s parameter \"%s\" in file \"%s\"\n",
+			ssvTypeNames[type], varName, xml->fileName);
+		return NULL;
+	}
+	*line = (int)entry->value[type]->parent->line;
+	if (entry->count[type] > 1) {
+		ModelicaFormatError("Error: More than one %s parameter \"%s\" found in file \"%s\"\n",
+			ssvTypeNames[type], varName, xml->fileName);
+		return NULL;
+	}
+	token = getAttrText(entry->value[type]);
+	if (NULL == token) {
+		xml->log("Line %i: Cannot read value of %s parameter \"%s\" from file \"%s\"\n",
+			*line, ssvTypeNames[type], varName, xml->fileName);
+		return NULL;
+	}
+	if (NULL != unit) {
+		*unit = entry->unit[type];
+	}
+	*exist = 1;
+	return token;
+}
+
+double ED_getDoubleFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist)
+{
+	double ret = 0.;
+	XML2File* xml = (XML2File*)_xml;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		int line;
+		const char* token = findSSVValue(xml, varName, nameSpace, SSV_REAL, &line, exist, NULL);
+		if (NULL != token && ED_strtod((char*)token, xml->loc, &ret, ED_STRICT)) {
+			ModelicaFormatError("Error in line %i: Cannot read double value \"%s\" from file \"%s\"\n",
+				line, token, xml->fileName);
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return ret;
+}
+
+int ED_getIntFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist)
+{
+	long ret = 0;
+	XML2File* xml = (XML2File*)_xml;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		int line;
+		const char* token = findSSVValue(xml, varName, nameSpace, SSV_INTEGER, &line, exist, NULL);
+		if (NULL != token && ED_strtol((char*)token, xml->loc, &ret, ED_STRICT)) {
+			ModelicaFormatError("Error in line %i: Cannot read int value \"%s\" from file \"%s\"\n",
+				line, token, xml->fileName);
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return (int)ret;
+}
+
+int ED_getBooleanFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist)
+{
+	XML2File* xml = (XML2File*)_xml;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		int line;
+		const char* token = findSSVValue(xml, varName, nameSpace, SSV_BOOLEAN, &line, exist, NULL);
+		if (NULL != token) {
+			return 0 == strcmp(token, "true") || 0 == strcmp(token, "1");
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return 0;
+}
+
+const char* ED_getStringFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist)
+{
+	XML2File* xml = (XML2File*)_xml;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		int line;
+		const char* token = findSSVValue(xml, varName, nameSpace, SSV_STRING, &line, exist, NULL);
+		if (NULL != token) {
+			char* ret = ModelicaAllocateStringWithErrorReturn(strlen(token));
+			if (ret != NULL) {
+				strcpy(ret, token);
+				return (const char*)ret;
+			}
+			ModelicaError("Memory allocation error\n");
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return "";
+}
+
+const char* ED_getUnitFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist)
+{
+	XML2File* xml = (XML2File*)_xml;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		int line;
+		xmlAttrPtr unit = NULL;
+		if (NULL != findSSVValue(xml, varName, nameSpace, SSV_REAL, &line, exist, &unit)) {
+			const char* token = getAttrText(unit);
+			if (NULL == token) {
+				xml->log("Line %i: Cannot find unit of Real parameter \"%s\" in file \"%s\"\n",
+					line, varName, xml->fileName);
+				*exist = 0;
+			}
+			else {
+				char* ret = ModelicaAllocateStringWithErrorReturn(strlen(token));
+				if (ret != NULL) {
+					strcpy(ret, token);
+					return (const char*)ret;
+				}
+				ModelicaError("Memory allocation error\n");
+			}
+		}
+	}
+	else {
+		*exist = 0;
+	}
+	return "";
+}
+
+/* Real parameter varName of an SSV file of version 2.0 or later (for arrays) */
+static SSVParameter* getSSVArrayParameter(XML2File* xml, const char* varName, const char* nameSpace)
+{
+	SSVParameter* entry = findSSVParameter(xml, varName, nameSpace);
+	if (xml->ssvVersion < 2.0) {
+		ModelicaFormatError("Error: SSV version needs to be greater than or equal to 2.0 in file \"%s\"\n",
+			xml->fileName);
+		return NULL;
+	}
+	if (NULL == entry || 0 == entry->count[SSV_REAL]) {
+		ModelicaFormatError("Error: Cannot find Real parameter \"%s\" in file \"%s\"\n",
+			varName, xml->fileName);
+		return NULL;
+	}
+	if (entry->count[SSV_REAL] > 1) {
+		ModelicaFormatError("Error: More than one Real parameter \"%s\" found in file \"%s\"\n",
+			varName, xml->fileName);
+		return NULL;
+	}
+	return entry;
+}
+
+void ED_getDoubleArray1DFromSSV(void* _xml, const char* varName, const char* nameSpace, double* a, size_t n)
+{
+	XML2File* xml = (XML2File*)_xml;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		SSVParameter* entry = getSSVArrayParameter(xml, varName, nameSpace);
+		if (NULL != entry) {
+			int line = (int)entry->value[SSV_REAL]->parent->line;
+			const char* token = getAttrText(entry->value[SSV_REAL]);
+			size_t nRead = 0;
+			NumListError err;
+			int ret = ED_OK;
+			if (NULL != token) {
+				ret = ED_strtodNumList(token, token + strlen(token), xml->loc, a, n, &nRead, &err);
+			}
+			if (ED_OOM == ret) {
+				ModelicaError("Memory allocation error\n");
+			}
+			else if (ED_OK != ret) {
+				ModelicaFormatError("Error in line %i, position %lu: Cannot read double value \"%.*s\" of parameter \"%s\" from file \"%s\"\n",
+					line + err.line, (unsigned long)err.pos, (int)err.len, err.token, varName, xml->fileName);
+			}
+			else if (nRead < n) {
+				ModelicaFormatError("Error in line %i: Cannot read %lu double values of parameter \"%s\" from file \"%s\"\n",
+					line, (unsigned long)n, varName, xml->fileName);
+			}
+		}
+	}
+}
+
+void ED_getDoubleArray2DFromSSV(void* _xml, const char* varName, const char* nameSpace, double* a, size_t m, size_t n)
+{
+	ED_getDoubleArray1DFromSSV(_xml, varName, nameSpace, a, m*n);
+}
+
+int ED_getArrayDimensionFromSSV(void* _xml, const char* varName, const char* nameSpace, int dim, int* exist)
+{
+	long ret = 0;
+	XML2File* xml = (XML2File*)_xml;
+	*exist = 0;
+	ED_PTR_CHECK(xml);
+	if (xml != NULL) {
+		SSVParameter* entry = getSSVArrayParameter(xml, varName, nameSpace);
+		/* Dimension elements are of the name space registered for prefix ssc */
+		const char* sscNameSpace = '\0' == *nameSpace ? "" :
+			(const char*)xmlXPathNsLookup(xml->xpathCtx, (const xmlChar*)"ssc");
+		if (NULL != entry && NULL != sscNameSpace) {
+			/* Find the dim-th Dimension element of the parameter */
+			xmlNodePtr child = entry->value[SSV_REAL]->parent->parent->children;
+			for (; NULL != child; child = child->next) {
+				if (isSSVElement(child, "Dimension", sscNameSpace) && 0 == --dim) {
+					const char* token = getAttrText(xmlHasProp(child, (const xmlChar*)"size"));
+					if (NULL != token) {
+						if (ED_strtol((char*)token, xml->loc, &ret, ED_STRICT)) {
+							ModelicaFormatError("Error in line %i: Cannot read int value \"%s\" from file \"%s\"\n",
+								(int)child->line, token, xml->fileName);
+						}
+						else {
+							*exist = 1;
+						}
+					}
+					break;
+				}
+			}
+		}
+	}
+	return (int)ret;
+}
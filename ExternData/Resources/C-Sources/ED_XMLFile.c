@@ -15,33 +15,31 @@
 #define strdup _strdup
 #endif
 #include "ED_locale.h"
+#include "ED_numlist.h"
 #include "ED_logging.h"
 #include "ED_ptrtrack.h"
 #include "bsxml.h"
 #include "ModelicaUtilities.h"
 #include "ED_XMLFile.h"
+#define HASH_NONFATAL_OOM 1
+#include "uthash.h"
 
-/* The standard way to detect posix is to check _POSIX_VERSION,
- * which is defined in <unistd.h>
- */
-#if defined(__unix__) || defined(__linux__) || defined(__APPLE_CC__)
-#include <unistd.h>
-#endif
-#if !defined(_POSIX_) && defined(_POSIX_VERSION)
-#define _POSIX_ 1
-#endif
-
-/* Use re-entrant string tokenize function if available */
-#if defined(_POSIX_)
-#elif defined(_MSC_VER) && _MSC_VER >= 1400
-#define strtok_r(str, delim, saveptr) strtok_s((str), (delim), (saveptr))
-#else
-#define strtok_r(str, delim, saveptr) strtok((str), (delim))
-#endif
+/* Resolved element path (or path prefix) with memoized values */
+typedef struct {
+	char* path; /* Key */
+	XmlNodeRef node;
+	XmlNodeRef parent;
+	int hasDouble;
+	int hasInt;
+	double doubleValue;
+	long intValue;
+	UT_hash_handle hh;
+} XMLPath;
 
 typedef struct {
 	char* fileName;
 	XmlNodeRef root;
+	XMLPath* paths;
 	ED_LOCALE_TYPE loc;
 	ED_LOGGING_FUNC log;
 } XMLFile;
@@ -79,6 +77,7 @@ void* ED_createXML(const char* fileName, int verbose, int detectMissingData)
 		}
 		return NULL;
 	}
+	xml->paths = NULL;
 	xml->loc = ED_INIT_LOCALE;
 	switch (detectMissingData) {
 		case ED_LOG_NONE:
@@ -103,9 +102,16 @@ void ED_destroyXML(void* _xml)
 	XMLFile* xml = (XMLFile*)_xml;
 	ED_PTR_CHECK(xml);
 	if (xml != NULL) {
+		XMLPath* iter;
+		XMLPath* tmp;
 		if (xml->fileName != NULL) {
 			free(xml->fileName);
 		}
+		HASH_ITER(hh, xml->paths, iter, tmp) {
+			HASH_DEL(xml->paths, iter);
+			free(iter->path);
+			free(iter);
+		}
 		XmlNode_deleteTree(xml->root);
 		ED_FREE_LOCALE(xml->loc);
 		free(xml);
@@ -113,42 +119,101 @@ void ED_destroyXML(void* _xml)
 	}
 }
 
-static char* findValue(XMLFile* xml, XmlNodeRef* root, XmlNodeRef* parent, const char* varName)
+static XMLPath* addPath(XMLFile* xml, const char* path, size_t len, XmlNodeRef node, XmlNodeRef parent)
+{
+	XMLPath* entry = (XMLPath*)calloc(1, sizeof(XMLPath));
+	if (entry == NULL) {
+		return NULL;
+	}
+	entry->path = (char*)malloc(len + 1);
+	if (entry->path == NULL) {
+		free(entry);
+		return NULL;
+	}
+	memcpy(entry->path, path, len);
+	entry->path[len] = '\0';
+	entry->node = node;
+	entry->parent = parent;
+	HASH_ADD_KEYPTR(hh, xml->paths, entry->path, len, entry);
+	if (NULL == entry->hh.tbl) {
+		free(entry->path);
+		free(entry);
+		return NULL;
+	}
+	return entry;
+}
+
+static char* findValue(XMLFile* xml, XmlNodeRef* root, XmlNodeRef* parent, const char* varName, XMLPath** path)
 {
 	char* token = NULL;
-	char* varNameCopy = strdup(varName);
-	if (varNameCopy != NULL) {
-		int elementError = 0;
-		char* nextToken = NULL;
-		token = strtok_r(varNameCopy, ".", &nextToken);
-		if (token == NULL) {
-			elementError = 1;
+	XMLPath* entry = NULL;
+	size_t len = strlen(varName);
+	size_t pos = len;
+	HASH_FIND(hh, xml->paths, varName, len, entry);
+	if (entry == NULL) {
+		/* Resume from the longest already resolved path prefix */
+		while (pos > 0 && entry == NULL) {
+			pos--;
+			if (varName[pos] == '.') {
+				HASH_FIND(hh, xml->paths, varName, pos, entry);
+			}
 		}
-		while (token != NULL && elementError == 0) {
-			XmlNodeRef iter = XmlNode_findChild(*root, token);
-			if (NULL != iter) {
-				*parent = *root;
-				*root = iter;
-				token = strtok_r(NULL, ".", &nextToken);
+		if (entry != NULL) {
+			pos++;
+		}
+	}
+	if (entry != NULL) {
+		*parent = entry->parent;
+		*root = entry->node;
+	}
+	if (pos < len) {
+		char* varNameCopy = strdup(varName);
+		if (varNameCopy != NULL) {
+			int elementError = 0;
+			while (pos < len && elementError == 0) {
+				size_t end = pos;
+				while (end < len && varNameCopy[end] != '.') {
+					end++;
+				}
+				varNameCopy[end] = '\0';
+				if (end > pos) {
+					XmlNodeRef iter = XmlNode_findChild(*root, varNameCopy + pos);
+					if (NULL != iter) {
+						*parent = *root;
+						*root = iter;
+						entry = addPath(xml, varName, end, *root, *parent);
+					}
+					else {
+						elementError = 1;
+					}
+				}
+				pos = end + 1;
 			}
-			else {
-				elementError = 1;
+			free(varNameCopy);
+			if (entry == NULL && elementError == 0) {
+				/* Only delimiters or out of memory for the cache */
+				elementError = *root == xml->root;
+			}
+			if (0 != elementError) {
+				xml->log("Line %i: Cannot find element \"%s\" in file \"%s\"\n",
+					XmlNode_getLine(*root), varName, xml->fileName);
+				*root = NULL;
+				entry = NULL;
 			}
-		}
-		free(varNameCopy);
-		if (0 == elementError) {
-			XmlNode_getValue(*root, &token);
 		}
 		else {
-			xml->log("Line %i: Cannot find element \"%s\" in file \"%s\"\n",
-				XmlNode_getLine(*root), varName, xml->fileName);
-			*root = NULL;
-			token = NULL;
+			ModelicaError("Memory allocation error\n");
 		}
 	}
-	else {
-		ModelicaError("Memory allocation error\n");
+	else if (entry == NULL) {
+		xml->log("Line %i: Cannot find element \"%s\" in file \"%s\"\n",
+			XmlNode_getLine(*root), varName, xml->fileName);
+		*root = NULL;
+	}
+	if (NULL != *root) {
+		XmlNode_getValue(*root, &token);
 	}
+	*path = entry;
 	return token;
 }
 
@@ -160,13 +225,21 @@ double ED_getDoubleFromXML(void* _xml, const char* varName, int* exist)
 	if (xml != NULL) {
 		XmlNodeRef root = xml->root;
 		XmlNodeRef parent = NULL;
-		char* token = findValue(xml, &root, &parent, varName);
+		XMLPath* path;
+		char* token = findValue(xml, &root, &parent, varName, &path);
 		*exist = 1;
-		if (token != NULL) {
+		if (NULL != path && 0 != path->hasDouble) {
+			ret = path->doubleValue;
+		}
+		else if (token != NULL) {
 			if (ED_strtod(token, xml->loc, &ret, ED_STRICT)) {
 				ModelicaFormatError("Error in line %i: Cannot read double value \"%s\" from file \"%s\"\n",
 					XmlNode_getLine(root), token, xml->fileName);
 			}
+			else if (NULL != path) {
+				path->doubleValue = ret;
+				path->hasDouble = 1;
+			}
 		}
 		else if (NULL != root) {
 			*exist = 0;
@@ -190,7 +263,8 @@ const char* ED_getStringFromXML(void* _xml, const char* varName, int* exist)
 	if (xml != NULL) {
 		XmlNodeRef root = xml->root;
 		XmlNodeRef parent = NULL;
-		char* token = findValue(xml, &root, &parent, varName);
+		XMLPath* path;
+		char* token = findValue(xml, &root, &parent, varName, &path);
 		*exist = 1;
 		if (token != NULL) {
 			char* ret = ModelicaAllocateString(strlen(token));
@@ -220,13 +294,21 @@ int ED_getIntFromXML(void* _xml, const char* varName, int* exist)
 	if (xml != NULL) {
 		XmlNodeRef root = xml->root;
 		XmlNodeRef parent = NULL;
-		char* token = findValue(xml, &root, &parent, varName);
+		XMLPath* path;
+		char* token = findValue(xml, &root, &parent, varName, &path);
 		*exist = 1;
-		if (token != NULL) {
+		if (NULL != path && 0 != path->hasInt) {
+			ret = path->intValue;
+		}
+		else if (token != NULL) {
 			if (ED_strtol(token, xml->loc, &ret, ED_STRICT)) {
 				ModelicaFormatError("Error in line %i: Cannot read int value \"%s\" from file \"%s\"\n",
 					XmlNode_getLine(root), token, xml->fileName);
 			}
+			else if (NULL != path) {
+				path->intValue = ret;
+				path->hasInt = 1;
+			}
 		}
 		else if (NULL != root) {
 			*exist = 0;
@@ -251,83 +333,71 @@ void ED_getDoubleArray1DFromXML(void* _xml, const char* varName, double* a, size
 		XmlNodeRef root = xml->root;
 		XmlNodeRef parent = NULL;
 		int iLevel = 0;
-		char* token = findValue(xml, &root, &parent, varName);
+		XMLPath* path;
+		char* token = findValue(xml, &root, &parent, varName, &path);
 		while (NULL == token && NULL != root && XmlNode_getChildCount(root) > 0) {
 			/* Try children if root is empty */
+			parent = root;
 			root = XmlNode_getChild(root, 0);
 			XmlNode_getValue(root, &token);
 			iLevel++;
 		}
 		if (token != NULL) {
-			char* tokenCopy = strdup(token);
-			if (tokenCopy != NULL) {
-				size_t i = 0;
-				size_t iSibling = 0;
-				size_t nSiblings = XmlNode_getChildCount(parent);
-				int line = XmlNode_getLine(root);
-				int foundSibling = 0;
-				char* nextToken = NULL;
-				token = strtok_r(tokenCopy, "[]{},; \t", &nextToken);
-				while (i < n) {
-					if (token != NULL) {
-						if (ED_strtod(token, xml->loc, &a[i++], ED_STRICT)) {
-							free(tokenCopy);
-							ModelicaFormatError("Error in line %i: Cannot read double value \"%s\" from file \"%s\"\n",
-								line, token, xml->fileName);
+			size_t i = 0;
+			size_t iSibling = 0;
+			size_t nSiblings = XmlNode_getChildCount(parent);
+			int line = XmlNode_getLine(root);
+			int foundSibling = 0;
+			for (;;) {
+				size_t nRead;
+				NumListError err;
+				int ret = ED_strtodNumList(token, token + strlen(token), xml->loc, a + i, n - i, &nRead, &err);
+				if (ED_OOM == ret) {
+					ModelicaError("Memory allocation error\n");
+					return;
+				}
+				else if (ED_OK != ret) {
+					ModelicaFormatError("Error in line %i, position %lu: Cannot read double value \"%.*s\" from file \"%s\"\n",
+						line + err.line, (unsigned long)err.pos, (int)err.len, err.token, xml->fileName);
+					return;
+				}
+				i += nRead;
+				if (i >= n) {
+					break;
+				}
+				/* Retrieve value from next sibling */
+				token = NULL;
+				while (NULL == token && ++iSibling < nSiblings) {
+					XmlNodeRef child = XmlNode_getChild(parent, iSibling);
+					if (child != root && XmlNode_isTag(child, XmlNode_getTag(root))) {
+						foundSibling = 1;
+						XmlNode_getValue(child, &token);
+						line = XmlNode_getLine(child);
+						if (NULL == token) {
+							ModelicaFormatError("Error in line %i: Cannot read empty (%lu.) element \"%s\" from file \"%s\"\n",
+								line, (unsigned long)(iSibling + 1), varName, xml->fileName);
 							return;
 						}
-						token = strtok_r(NULL, "[]{},; \t", &nextToken);
 					}
-					else if (++iSibling < nSiblings) {
-						/* Retrieve value from next sibling */
-						XmlNodeRef child = XmlNode_getChild(parent, iSibling);
-						if (child != root && XmlNode_isTag(child, XmlNode_getTag(root))) {
-							foundSibling = 1;
-							XmlNode_getValue(child, &token);
-							line = XmlNode_getLine(child);
-							free(tokenCopy);
-							if (token != NULL) {
-								tokenCopy = strdup(token);
-								if (tokenCopy != NULL) {
-									nextToken = NULL;
-									token = strtok_r(tokenCopy, "[]{},; \t", &nextToken);
-								}
-								else {
-									ModelicaError("Memory allocation error\n");
-									return;
-								}
-							}
-							else {
-								ModelicaFormatError("Error in line %i: Cannot read empty (%lu.) element \"%s\" from file \"%s\"\n",
-									line, (unsigned long)(iSibling + 1), varName, xml->fileName);
-								return;
-							}
+				}
+				if (NULL == token) {
+					/* Error: no (more) siblings */
+					if (foundSibling != 0) {
+						const char* levels[] = {"", "child ", "grandchild ", "great-grandchild ", "great-great-grandchild "};
+						XmlNodeRef child = XmlNode_getChild(parent, nSiblings - 1);
+						line = XmlNode_getLine(child);
+						if (iLevel > 4) {
+							iLevel = 0;
 						}
+						ModelicaFormatError("Error after line %i: Cannot find %lu. %selement of \"%s\" in file \"%s\"\n",
+							line, (unsigned long)(iSibling + 1), levels[iLevel], varName, xml->fileName);
 					}
 					else {
-						/* Error: token is NULL and no (more) siblings */
-						free(tokenCopy);
-						if (foundSibling != 0) {
-							const char* levels[] = {"", "child ", "grandchild ", "great-grandchild ", "great-great-grandchild "};
-							XmlNodeRef child = XmlNode_getChild(parent, nSiblings - 1);
-							line = XmlNode_getLine(child);
-							if (iLevel > 4) {
-								iLevel = 0;
-							}
-							ModelicaFormatError("Error after line %i: Cannot find %lu. %selement of \"%s\" in file \"%s\"\n",
-								line, (unsigned long)(iSibling + 1), levels[iLevel], varName, xml->fileName);
-						}
-						else {
-							ModelicaFormatError("Error in line %i: Cannot read %lu double values of \"%s\" from file \"%s\"\n",
-								line, (unsigned long)n, varName, xml->fileName);
-						}
-						return;
+						ModelicaFormatError("Error in line %i: Cannot read %lu double values of \"%s\" from file \"%s\"\n",
+							line, (unsigned long)n, varName, xml->fileName);
 					}
+					return;
 				}
-				free(tokenCopy);
-			}
-			else {
-				ModelicaError("Memory allocation error\n");
 			}
 		}
 		else if (NULL != root) {
@@ -363,73 +433,38 @@ void ED_getArray2DDimensionsFromXML(void* _xml, const char* varName, int* m, int
 		XmlNodeRef root = xml->root;
 		XmlNodeRef parent = NULL;
 		int iLevel = 0;
-		char* token = findValue(xml, &root, &parent, varName);
+		XMLPath* path;
+		char* token = findValue(xml, &root, &parent, varName, &path);
 		while (NULL == token && NULL != root && XmlNode_getChildCount(root) > 0) {
 			/* Try children if root is empty */
+			parent = root;
 			root = XmlNode_getChild(root, 0);
 			XmlNode_getValue(root, &token);
 			iLevel++;
 		}
 		if (NULL != token) {
-			char* tokenCopy = strdup(token);
-			if (NULL != tokenCopy) {
-				size_t nSiblings = XmlNode_getChildCount(parent);
-				char* nextToken = NULL;
-				if (0 == iLevel) {
-					char* sep = strchr(tokenCopy, ';');
-					_m = 1;
-					if (NULL != sep) {
-						do {
-							_m++;
-							sep = strchr(sep + 1, ';');
-						} while (NULL != sep);
-					}
-					else {
-						sep = strchr(tokenCopy, '}');
-						while (NULL != sep) {
-							sep = strchr(sep + 1, ',');
-							if (NULL != sep) {
-								_m++;
-								sep = strchr(sep + 1, '}');
-							}
-						}
-					}
-					token = strtok_r(tokenCopy, "[]{},; \t", &nextToken);
-					if (NULL != token) {
-						do {
-							_n++;
-							token = strtok_r(NULL, "[]{},; \t", &nextToken);
-						} while (NULL != token);
-						if (0 == _n%_m) {
-							_n /= _m;
-						}
-						else {
-							_m = 1;
-						}
-					}
-					free(tokenCopy);
+			size_t nSiblings = XmlNode_getChildCount(parent);
+			if (0 == iLevel) {
+				const char* sep = strchr(token, ';');
+				_m = 1;
+				if (NULL != sep) {
+					do {
+						_m++;
+						sep = strchr(sep + 1, ';');
+					} while (NULL != sep);
 				}
 				else {
-					size_t iSibling;
-					free(tokenCopy);
-					for (iSibling = 0; iSibling < nSiblings; iSibling++) {
-						XmlNodeRef child = XmlNode_getChild(parent, iSibling);
-						if (XmlNode_isTag(child, XmlNode_getTag(root))) {
-							XmlNode_getValue(child, &token);
-							if (NULL != token) {
-								tokenCopy = strdup(token);
-								if (NULL != tokenCopy) {
-									token = strtok_r(tokenCopy, "[]{},; \t", &nextToken);
-									while (NULL != token) {
-										_n++;
-										token = strtok_r(NULL, "[]{},; \t", &nextToken);
-									}
-									free(tokenCopy);
-								}
-							}
+					sep = strchr(token, '}');
+					while (NULL != sep) {
+						sep = strchr(sep + 1, ',');
+						if (NULL != sep) {
+							_m++;
+							sep = strchr(sep + 1, '}');
 						}
 					}
-					_m = (int)nSiblings;
+				}
+				_n = (int)ED_countNumList(token, token + strlen(token));
+				if (0 != _n) {
 					if (0 == _n%_m) {
 						_n /= _m;
 					}
@@ -438,6 +473,25 @@ void ED_getArray2DDimensionsFromXML(void* _xml, const char* varName, int* m, int
 					}
 				}
 			}
+			else {
+				size_t iSibling;
+				for (iSibling = 0; iSibling < nSiblings; iSibling++) {
+					XmlNodeRef child = XmlNode_getChild(parent, iSibling);
+					if (XmlNode_isTag(child, XmlNode_getTag(root))) {
+						XmlNode_getValue(child, &token);
+						if (NULL != token) {
+							_n += (int)ED_countNumList(token, token + strlen(token));
+						}
+					}
+				}
+				_m = (int)nSiblings;
+				if (0 == _n%_m) {
+					_n /= _m;
+				}
+				else {
+					_m = 1;
+				}
+			}
 		}
 	}
 	if (NULL != m)
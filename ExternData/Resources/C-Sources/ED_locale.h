@@ -37,6 +37,20 @@ static __inline int ED_strtod(char* token, ED_LOCALE_TYPE loc, double* val, int
 	return ret;
 }
 
+/* Convert the len characters of token that need not be null-terminated, but must be
+   followed by a character that cannot continue a number */
+static __inline int ED_strntod(const char* token, size_t len, ED_LOCALE_TYPE loc, double* val)
+{
+	int ret = ED_OK;
+	char* endptr;
+	*val = _strtod_l(token, &endptr, loc);
+	if (endptr != token + len) {
+		*val = 0.;
+		ret = ED_ERROR;
+	}
+	return ret;
+}
+
 static __inline int ED_strtol(char* token, ED_LOCALE_TYPE loc, long* val, int strict)
 {
 	int ret = ED_OK;
@@ -66,6 +80,20 @@ static inline int ED_strtod(char* token, ED_LOCALE_TYPE loc, double* val, int st
 	return ret;
 }
 
+/* Convert the len characters of token that need not be null-terminated, but must be
+   followed by a character that cannot continue a number */
+static inline int ED_strntod(const char* token, size_t len, ED_LOCALE_TYPE loc, double* val)
+{
+	int ret = ED_OK;
+	char* endptr;
+	*val = strtod_l(token, &endptr, loc);
+	if (endptr != token + len) {
+		*val = 0.;
+		ret = ED_ERROR;
+	}
+	return ret;
+}
+
 static inline int ED_strtol(char* token, ED_LOCALE_TYPE loc, long* val, int strict)
 {
 	int ret = ED_OK;
@@ -115,6 +143,38 @@ static int ED_strtod(char* token, ED_LOCALE_TYPE dec, double* val, int strict)
 	return ret;
 }
 
+/* Convert the len characters of token that need not be null-terminated */
+static int ED_strntod(const char* token, size_t len, ED_LOCALE_TYPE dec, double* val)
+{
+	int ret = ED_OK;
+	char buf[64];
+	char* token2 = buf;
+	char* endptr;
+	if (len >= sizeof(buf)) {
+		token2 = malloc((len + 1)*sizeof(char));
+		if (token2 == NULL) {
+			return ED_OOM;
+		}
+	}
+	memcpy(token2, token, len);
+	token2[len] = '\0';
+	if (*dec != '.') {
+		char* p = strchr(token2, '.');
+		if (NULL != p) {
+			*p = *dec;
+		}
+	}
+	*val = strtod(token2, &endptr);
+	if (endptr != token2 + len) {
+		*val = 0.;
+		ret = ED_ERROR;
+	}
+	if (token2 != buf) {
+		free(token2);
+	}
+	return ret;
+}
+
 static int ED_strtol(char* token, ED_LOCALE_TYPE loc, long* val, int strict)
 {
 	int ret = ED_OK;
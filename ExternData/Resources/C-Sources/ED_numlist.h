@@ -0,0 +1,156 @@
+/* ED_numlist.h - Conversion of delimited lists of numbers
+ *
+ * Copyright (C) 2015-2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if !defined(ED_NUMLIST_H)
+#define ED_NUMLIST_H
+
+#include <stddef.h>
+#include "ED_locale.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ED_NUMLIST_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+/* Values are separated by any of the characters "[]{},; \t\r\n" */
+
+typedef struct {
+	const char* token; /* Invalid token */
+	size_t len; /* Length of invalid token */
+	int line; /* Number of line breaks preceding the invalid token */
+	size_t pos; /* Position (1-based) of invalid token in its line */
+} NumListError;
+
+static int ED_isNumListDelimiter(char c)
+{
+	switch (c) {
+		case '[':
+		case ']':
+		case '{':
+		case '}':
+		case ',':
+		case ';':
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+#if defined(ED_NUMLIST_SSE2)
+/* Bit i is set if p[i] is a delimiter */
+static unsigned int ED_numListDelimiterMask(const char* p)
+{
+	const __m128i v = _mm_loadu_si128((const __m128i*)p);
+	/* Setting bit 5 maps '[' to '{' and ']' to '}' */
+	const __m128i w = _mm_or_si128(v, _mm_set1_epi8(0x20));
+	__m128i m = _mm_cmpeq_epi8(w, _mm_set1_epi8('{'));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(w, _mm_set1_epi8('}')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(';')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+	m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+	return (unsigned int)_mm_movemask_epi8(m);
+}
+
+/* Index of lowest set bit of non-zero mask */
+static unsigned int ED_numListFirstBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+	unsigned long i;
+	_BitScanForward(&i, mask);
+	return (unsigned int)i;
+#else
+	return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+/* Skip delimiters (or non-delimiters if skipDelimiters is 0) in [p, end) */
+static const char* ED_skipNumListChars(const char* p, const char* end, int skipDelimiters)
+{
+#if defined(ED_NUMLIST_SSE2)
+	const unsigned int flip = skipDelimiters ? 0xFFFFu : 0u;
+	while (end - p >= 16) {
+		const unsigned int mask = (ED_numListDelimiterMask(p) ^ flip) & 0xFFFFu;
+		if (0 != mask) {
+			return p + ED_numListFirstBit(mask);
+		}
+		p += 16;
+	}
+#endif
+	while (p < end && ED_isNumListDelimiter(*p) == skipDelimiters) {
+		p++;
+	}
+	return p;
+}
+
+/* Count the values in [begin, end) */
+static size_t ED_countNumList(const char* begin, const char* end)
+{
+	size_t count = 0;
+	const char* p = ED_skipNumListChars(begin, end, 1);
+	while (p < end) {
+		count++;
+		p = ED_skipNumListChars(p, end, 0);
+		p = ED_skipNumListChars(p, end, 1);
+	}
+	return count;
+}
+
+/* Convert up to n values of [begin, end) into a without copying. The range needs
+   to be followed by a delimiter or null character. On return *nRead holds the
+   number of converted values. If a value cannot be converted, ED_ERROR is
+   returned and err locates the invalid token. */
+static int ED_strtodNumList(const char* begin, const char* end, ED_LOCALE_TYPE loc, double* a, size_t n, size_t* nRead, NumListError* err)
+{
+	size_t i = 0;
+	const char* p = begin;
+	while (i < n) {
+		const char* tokenEnd;
+		int ret;
+		p = ED_skipNumListChars(p, end, 1);
+		if (p >= end) {
+			break;
+		}
+		tokenEnd = ED_skipNumListChars(p, end, 0);
+		ret = ED_strntod(p, (size_t)(tokenEnd - p), loc, &a[i]);
+		if (ED_OK != ret) {
+			if (NULL != err) {
+				const char* lineStart = begin;
+				const char* q;
+				err->token = p;
+				err->len = (size_t)(tokenEnd - p);
+				err->line = 0;
+				for (q = begin; q < p; q++) {
+					if (*q == '\n') {
+						err->line++;
+						lineStart = q + 1;
+					}
+				}
+				err->pos = (size_t)(p - lineStart) + 1;
+			}
+			*nRead = i;
+			return ret;
+		}
+		i++;
+		p = tokenEnd;
+	}
+	*nRead = i;
+	return ED_OK;
+}
+
+#endif
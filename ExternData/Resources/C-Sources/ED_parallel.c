@@ -0,0 +1,178 @@
+/* ED_parallel.c - Simple parallel loop on a pool of worker threads
+ *
+ * Copyright (C) 2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <stdlib.h>
+#if defined(ED_NO_THREADS)
+/* Serial execution only */
+#elif defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <process.h>
+#define ED_HAVE_THREADS 1
+#define ED_HAVE_WIN32_THREADS 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define ED_HAVE_THREADS 1
+#endif
+#include "ED_parallel.h"
+
+typedef struct {
+	ED_PARALLEL_FUNC func;
+	void* data;
+	size_t nJobs;
+	size_t next; /* Next job to be taken */
+#if defined(ED_HAVE_WIN32_THREADS)
+	CRITICAL_SECTION lock;
+#elif defined(ED_HAVE_THREADS)
+	pthread_mutex_t lock;
+#endif
+} ParallelFor;
+
+typedef struct {
+	ParallelFor* pf;
+	size_t thread;
+} Worker;
+
+static int nextJob(ParallelFor* pf, size_t* job)
+{
+	int ret = 0;
+#if defined(ED_HAVE_WIN32_THREADS)
+	EnterCriticalSection(&pf->lock);
+#elif defined(ED_HAVE_THREADS)
+	pthread_mutex_lock(&pf->lock);
+#endif
+	if (pf->next < pf->nJobs) {
+		*job = pf->next++;
+		ret = 1;
+	}
+#if defined(ED_HAVE_WIN32_THREADS)
+	LeaveCriticalSection(&pf->lock);
+#elif defined(ED_HAVE_THREADS)
+	pthread_mutex_unlock(&pf->lock);
+#endif
+	return ret;
+}
+
+static void runWorker(Worker* worker)
+{
+	size_t job;
+	while (nextJob(worker->pf, &job)) {
+		worker->pf->func(worker->pf->data, worker->thread, job);
+	}
+}
+
+#if defined(ED_HAVE_WIN32_THREADS)
+static unsigned __stdcall workerMain(void* arg)
+{
+	runWorker((Worker*)arg);
+	return 0;
+}
+#elif defined(ED_HAVE_THREADS)
+static void* workerMain(void* arg)
+{
+	runWorker((Worker*)arg);
+	return NULL;
+}
+#endif
+
+size_t ED_getNumberOfThreads(size_t nJobs)
+{
+	size_t n = 1;
+#if defined(ED_HAVE_WIN32_THREADS)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	n = (size_t)info.dwNumberOfProcessors;
+#elif defined(ED_HAVE_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+	const long nProcs = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nProcs > 0) {
+		n = (size_t)nProcs;
+	}
+#endif
+	if (n > nJobs) {
+		n = nJobs;
+	}
+	return n > 0 ? n : 1;
+}
+
+void ED_parallelFor(ED_PARALLEL_FUNC func, void* data, size_t nJobs, size_t nThreads)
+{
+	ParallelFor pf;
+	Worker* workers = NULL;
+	pf.func = func;
+	pf.data = data;
+	pf.nJobs = nJobs;
+	pf.next = 0;
+	if (nThreads > nJobs) {
+		nThreads = nJobs;
+	}
+#if defined(ED_HAVE_THREADS)
+	if (nThreads > 1) {
+		workers = (Worker*)malloc(nThreads*sizeof(Worker));
+	}
+#endif
+	if (workers == NULL) {
+		/* Serial execution */
+		size_t job;
+		for (job = 0; job < nJobs; job++) {
+			func(data, 0, job);
+		}
+		return;
+	}
+#if defined(ED_HAVE_WIN32_THREADS)
+	{
+		HANDLE* handles = (HANDLE*)calloc(nThreads, sizeof(HANDLE));
+		size_t i;
+		InitializeCriticalSection(&pf.lock);
+		/* The calling thread acts as worker 0 */
+		for (i = 1; handles != NULL && i < nThreads; i++) {
+			workers[i].pf = &pf;
+			workers[i].thread = i;
+			handles[i] = (HANDLE)_beginthreadex(NULL, 0, workerMain, &workers[i], 0, NULL);
+		}
+		workers[0].pf = &pf;
+		workers[0].thread = 0;
+		runWorker(&workers[0]);
+		for (i = 1; handles != NULL && i < nThreads; i++) {
+			if (handles[i] != NULL) {
+				WaitForSingleObject(handles[i], INFINITE);
+				CloseHandle(handles[i]);
+			}
+		}
+		DeleteCriticalSection(&pf.lock);
+		free(handles);
+	}
+#elif defined(ED_HAVE_THREADS)
+	{
+		pthread_t* threads = (pthread_t*)calloc(nThreads, sizeof(pthread_t));
+		int* started = (int*)calloc(nThreads, sizeof(int));
+		size_t i;
+		pthread_mutex_init(&pf.lock, NULL);
+		/* The calling thread acts as worker 0 */
+		for (i = 1; threads != NULL && started != NULL && i < nThreads; i++) {
+			workers[i].pf = &pf;
+			workers[i].thread = i;
+			started[i] = 0 == pthread_create(&threads[i], NULL, workerMain, &workers[i]);
+		}
+		workers[0].pf = &pf;
+		workers[0].thread = 0;
+		runWorker(&workers[0]);
+		for (i = 1; threads != NULL && started != NULL && i < nThreads; i++) {
+			if (started[i]) {
+				pthread_join(threads[i], NULL);
+			}
+		}
+		pthread_mutex_destroy(&pf.lock);
+		free(started);
+		free(threads);
+	}
+#endif
+	free(workers);
+}
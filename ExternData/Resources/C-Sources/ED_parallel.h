@@ -0,0 +1,25 @@
+/* ED_parallel.h - Simple parallel loop on a pool of worker threads
+ *
+ * Copyright (C) 2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if !defined(ED_PARALLEL_H)
+#define ED_PARALLEL_H
+
+#include <stddef.h>
+
+/* Job function: thread is the index of the executing worker in [0, nThreads),
+   job is the index of the job in [0, nJobs) */
+typedef void (*ED_PARALLEL_FUNC)(void* data, size_t thread, size_t job);
+
+/* Number of worker threads to use for nJobs jobs (at least one) */
+size_t ED_getNumberOfThreads(size_t nJobs);
+
+/* Run all jobs on nThreads workers and return when all of them are done.
+   Falls back to serial execution if no threads can be created. */
+void ED_parallelFor(ED_PARALLEL_FUNC func, void* data, size_t nJobs, size_t nThreads);
+
+#endif
@@ -0,0 +1,680 @@
+/* ED_workbook.c - Zip package and cell grid functions shared by XLSX and XLSB
+ *
+ * Copyright (C) 2015-2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if defined(__gnu_linux__)
+#define _GNU_SOURCE 1
+#endif
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#define strdup _strdup
+#endif
+#include "ED_parallel.h"
+#include "ED_workbook.h"
+#include "ModelicaUtilities.h"
+
+void ED_rc(const char* cellAddress, DWORD* row, DWORD* col)
+{
+	DWORD i = 0, j;
+	while (cellAddress[i++] >= 'A');
+	i--;
+	/* i now points to first character of row address */
+	*col = 0;
+	for (j = 0; j < i; j++) {
+		*col *= 26;
+		*col += toupper(cellAddress[j]) - 'A' + 1;
+	}
+	*row = (DWORD)strtoul(cellAddress + i, NULL, 10);
+	if (*col > 0)
+		(*col)--;
+	if (*row > 0)
+		(*row)--;
+}
+
+void ED_freeCentralDirectory(ZipEntry** entries)
+{
+	ZipEntry* iter;
+	ZipEntry* tmp;
+	HASH_ITER(hh, *entries, iter, tmp) {
+		HASH_DEL(*entries, iter);
+		free(iter->name);
+		free(iter);
+	}
+}
+
+int ED_readCentralDirectory(unzFile zfile, ZipEntry** entries)
+{
+	int rc = unzGoToFirstFile(zfile);
+	*entries = NULL;
+	while (rc == UNZ_OK) {
+		unz_file_info64 info;
+		ZipEntry* entry;
+		char* name;
+		if (unzGetCurrentFileInfo64(zfile, &info, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK) {
+			ED_freeCentralDirectory(entries);
+			return E_EGETFILEINFO;
+		}
+		name = (char*)malloc(info.size_filename + 1);
+		if (name == NULL) {
+			ED_freeCentralDirectory(entries);
+			return E_NO_MEMORY;
+		}
+		if (unzGetCurrentFileInfo64(zfile, NULL, name, info.size_filename + 1, NULL, 0, NULL, 0) != UNZ_OK) {
+			free(name);
+			ED_freeCentralDirectory(entries);
+			return E_EGETFILEINFO;
+		}
+		HASH_FIND_STR(*entries, name, entry);
+		if (entry != NULL) {
+			/* Keep the first of duplicate names like unzLocateFile does */
+			free(name);
+		}
+		else {
+			entry = (ZipEntry*)malloc(sizeof(ZipEntry));
+			if (entry == NULL) {
+				free(name);
+				ED_freeCentralDirectory(entries);
+				return E_NO_MEMORY;
+			}
+			entry->name = name;
+			if (unzGetFilePos64(zfile, &entry->pos) != UNZ_OK) {
+				free(entry->name);
+				free(entry);
+				ED_freeCentralDirectory(entries);
+				return E_EGETFILEINFO;
+			}
+			HASH_ADD_KEYPTR(hh, *entries, entry->name, strlen(entry->name), entry);
+			if (NULL == entry->hh.tbl) {
+				free(entry->name);
+				free(entry);
+				ED_freeCentralDirectory(entries);
+				return E_NO_MEMORY;
+			}
+		}
+		rc = unzGoToNextFile(zfile);
+	}
+	return 0;
+}
+
+int ED_locateFile(unzFile zfile, ZipEntry* entries, const char* fileName)
+{
+	ZipEntry* entry;
+	HASH_FIND_STR(entries, fileName, entry);
+	if (entry == NULL || unzGoToFilePos64(zfile, &entry->pos) != UNZ_OK) {
+		return E_ELOCATE;
+	}
+	return 0;
+}
+
+int ED_streamXML(unzFile zfile, ZipEntry* entries, const char* fileName, XML_Parser parser)
+{
+	int rc;
+	int len;
+	rc = ED_locateFile(zfile, entries, fileName);
+	if (rc != 0) {
+		return rc;
+	}
+	rc = unzOpenCurrentFile(zfile);
+	if (rc != UNZ_OK) {
+		return E_EOPEN;
+	}
+	do {
+		void* buf = XML_GetBuffer(parser, READ_BUFFER_SIZE);
+		if (NULL == buf) {
+			rc = E_NO_MEMORY;
+			break;
+		}
+		len = unzReadCurrentFile(zfile, buf, READ_BUFFER_SIZE);
+		if (len < 0) {
+			rc = E_EREAD;
+			break;
+		}
+		if (XML_STATUS_ERROR == XML_ParseBuffer(parser, len, len == 0)) {
+			rc = E_BAD_DATA;
+			break;
+		}
+	} while (len > 0);
+	unzCloseCurrentFile(zfile);
+	return rc;
+}
+
+const char* ED_localName(const XML_Char* name)
+{
+	const char* colon = strchr(name, ':');
+	return NULL != colon ? colon + 1 : name;
+}
+
+const char* ED_findAttribute(const XML_Char** atts, const char* name)
+{
+	for (; NULL != atts[0]; atts += 2) {
+		if (0 == strcmp(ED_localName(atts[0]), name)) {
+			return atts[1];
+		}
+	}
+	return NULL;
+}
+
+static void XMLCALL relsStartElement(void* userData, const XML_Char* name, const XML_Char** atts)
+{
+	RelsParser* rp = (RelsParser*)userData;
+	if (0 == strcmp(ED_localName(name), "Relationship")) {
+		const char* id = ED_findAttribute(atts, "Id");
+		const char* target = ED_findAttribute(atts, "Target");
+		if (id != NULL && target != NULL) {
+			if (rp->count == rp->capacity) {
+				size_t capacity = rp->capacity > 0 ? 2*rp->capacity : 16;
+				Relationship* rels = (Relationship*)realloc(rp->rels, capacity*sizeof(Relationship));
+				if (rels == NULL) {
+					rp->rc = E_NO_MEMORY;
+					XML_StopParser(rp->parser, XML_FALSE);
+					return;
+				}
+				rp->rels = rels;
+				rp->capacity = capacity;
+			}
+			rp->rels[rp->count].id = strdup(id);
+			rp->rels[rp->count].target = strdup(target);
+			rp->count++;
+			if (rp->rels[rp->count - 1].id == NULL || rp->rels[rp->count - 1].target == NULL) {
+				rp->rc = E_NO_MEMORY;
+				XML_StopParser(rp->parser, XML_FALSE);
+			}
+		}
+	}
+}
+
+int ED_parseRels(unzFile zfile, ZipEntry* entries, const char* fileName, RelsParser* rp)
+{
+	int rc;
+	memset(rp, 0, sizeof(RelsParser));
+	rp->parser = XML_ParserCreate(NULL);
+	if (rp->parser == NULL) {
+		return E_NO_MEMORY;
+	}
+	XML_SetUserData(rp->parser, rp);
+	XML_SetStartElementHandler(rp->parser, relsStartElement);
+	rc = ED_streamXML(zfile, entries, fileName, rp->parser);
+	if (rp->rc != 0) {
+		/* Error raised by a callback */
+		rc = rp->rc;
+	}
+	XML_ParserFree(rp->parser);
+	rp->parser = NULL;
+	return rc;
+}
+
+void ED_freeRels(RelsParser* rp)
+{
+	size_t i;
+	for (i = 0; i < rp->count; i++) {
+		free(rp->rels[i].id);
+		free(rp->rels[i].target);
+	}
+	free(rp->rels);
+	memset(rp, 0, sizeof(RelsParser));
+}
+
+char* ED_resolveSheetPath(const RelsParser* rp, const char* sheetId)
+{
+	size_t i;
+	for (i = 0; i < rp->count; i++) {
+		if (0 == strcmp(sheetId, rp->rels[i].id)) {
+			/* Target is relative to xl/ unless absolute within the package */
+			const char* target = rp->rels[i].target;
+			const char* folderPrefix = target[0] == '/' ? "" : "xl/";
+			char* sheetPath;
+			if (target[0] == '/') {
+				target++;
+			}
+			sheetPath = (char*)malloc((strlen(folderPrefix) + strlen(target) + 1)*sizeof(char));
+			if (sheetPath != NULL) {
+				strcpy(sheetPath, folderPrefix);
+				strcat(sheetPath, target);
+			}
+			return sheetPath;
+		}
+	}
+	return NULL;
+}
+
+int ED_addSheetRow(SheetBuilder* sb, DWORD row)
+{
+	Sheet* sheet = sb->sheet;
+	if (sheet->nRows == sb->rowsCapacity) {
+		size_t capacity = sb->rowsCapacity > 0 ? 2*sb->rowsCapacity : 64;
+		SheetRow* rows = (SheetRow*)realloc(sheet->rows, capacity*sizeof(SheetRow));
+		if (NULL == rows) {
+			return E_NO_MEMORY;
+		}
+		sheet->rows = rows;
+		sb->rowsCapacity = capacity;
+	}
+	sb->row = &sheet->rows[sheet->nRows++];
+	sb->row->row = row;
+	sb->row->first = sheet->nCells;
+	sb->row->count = 0;
+	return 0;
+}
+
+int ED_nextSheetCell(SheetBuilder* sb, SheetCell** cell)
+{
+	Sheet* sheet = sb->sheet;
+	*cell = NULL;
+	if (NULL == sb->row) {
+		/* Cell outside of a row */
+		return 0;
+	}
+	if (sheet->nCells == sb->cellsCapacity) {
+		size_t capacity = sb->cellsCapacity > 0 ? 2*sb->cellsCapacity : 256;
+		SheetCell* cells = (SheetCell*)realloc(sheet->cells, capacity*sizeof(SheetCell));
+		if (NULL == cells) {
+			return E_NO_MEMORY;
+		}
+		sheet->cells = cells;
+		sb->cellsCapacity = capacity;
+	}
+	*cell = &sheet->cells[sheet->nCells];
+	return 0;
+}
+
+void ED_commitSheetCell(SheetBuilder* sb)
+{
+	sb->sheet->nCells++;
+	sb->row->count++;
+}
+
+char* ED_reserveSheetText(SheetBuilder* sb, size_t len)
+{
+	Sheet* sheet = sb->sheet;
+	if (sheet->textSize + len + 1 > sb->textCapacity) {
+		size_t capacity = sb->textCapacity > 0 ? 2*sb->textCapacity : 4096;
+		char* text;
+		while (sheet->textSize + len + 1 > capacity) {
+			capacity *= 2;
+		}
+		text = (char*)realloc(sheet->text, capacity);
+		if (NULL == text) {
+			return NULL;
+		}
+		sheet->text = text;
+		sb->textCapacity = capacity;
+	}
+	return sheet->text + sheet->textSize;
+}
+
+void ED_commitSheetText(SheetBuilder* sb, SheetCell* cell, size_t len)
+{
+	Sheet* sheet = sb->sheet;
+	cell->text = sheet->textSize;
+	sheet->text[sheet->textSize + len] = '\0';
+	sheet->textSize += len + 1;
+}
+
+static int rowComparer(const void* a, const void* b)
+{
+	const DWORD rowA = ((const SheetRow*)a)->row;
+	const DWORD rowB = ((const SheetRow*)b)->row;
+	return rowA < rowB ? -1 : (rowA > rowB ? 1 : 0);
+}
+
+static int cellComparer(const void* a, const void* b)
+{
+	const DWORD colA = ((const SheetCell*)a)->col;
+	const DWORD colB = ((const SheetCell*)b)->col;
+	return colA < colB ? -1 : (colA > colB ? 1 : 0);
+}
+
+void ED_indexSheet(Sheet* sheet)
+{
+	/* Rows and cells are almost always stored in order already */
+	size_t i, j;
+	for (i = 1; i < sheet->nRows; i++) {
+		if (sheet->rows[i].row < sheet->rows[i - 1].row) {
+			qsort(sheet->rows, sheet->nRows, sizeof(SheetRow), rowComparer);
+			break;
+		}
+	}
+	for (i = 0; i < sheet->nRows; i++) {
+		SheetCell* cells = sheet->cells + sheet->rows[i].first;
+		for (j = 1; j < sheet->rows[i].count; j++) {
+			if (cells[j].col < cells[j - 1].col) {
+				qsort(cells, sheet->rows[i].count, sizeof(SheetCell), cellComparer);
+				break;
+			}
+		}
+	}
+	/* Direct row lookup unless the rows are too sparse */
+	if (sheet->nRows > 0) {
+		const size_t nRowIndex = (size_t)sheet->rows[sheet->nRows - 1].row + 1;
+		if (nRowIndex <= 4*sheet->nRows) {
+			sheet->rowIndex = (DWORD*)calloc(nRowIndex, sizeof(DWORD));
+			if (NULL != sheet->rowIndex) {
+				sheet->nRowIndex = nRowIndex;
+				for (i = 0; i < sheet->nRows; i++) {
+					sheet->rowIndex[sheet->rows[i].row] = (DWORD)(i + 1);
+				}
+			}
+		}
+	}
+}
+
+void ED_freeSheet(Sheet* sheet)
+{
+	if (NULL != sheet) {
+		free(sheet->text);
+		free(sheet->cells);
+		free(sheet->rows);
+		free(sheet->rowIndex);
+		free(sheet);
+	}
+}
+
+const SheetRow* ED_lowerBoundRow(const Sheet* sheet, DWORD row)
+{
+	/* First row not less than row */
+	size_t lo = 0, hi = sheet->nRows;
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo)/2;
+		if (sheet->rows[mid].row < row) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return sheet->rows + lo;
+}
+
+const SheetCell* ED_lowerBoundCell(const Sheet* sheet, const SheetRow* iter, DWORD col)
+{
+	/* First cell of row not left of col */
+	const SheetCell* cells = sheet->cells + iter->first;
+	size_t lo = 0, hi = iter->count;
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo)/2;
+		if (cells[mid].col < col) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return cells + lo;
+}
+
+const SheetCell* ED_findSheetCell(const Sheet* sheet, DWORD row, DWORD col)
+{
+	const SheetRow* iter = NULL;
+	const SheetCell* cell = NULL;
+	if (NULL != sheet->rowIndex) {
+		if (row < sheet->nRowIndex && sheet->rowIndex[row] > 0) {
+			iter = sheet->rows + sheet->rowIndex[row] - 1;
+		}
+	}
+	else {
+		iter = ED_lowerBoundRow(sheet, row);
+		if (iter == sheet->rows + sheet->nRows || iter->row != row) {
+			iter = NULL;
+		}
+	}
+	if (iter != NULL) {
+		cell = ED_lowerBoundCell(sheet, iter, col);
+		if (cell == sheet->cells + iter->first + iter->count || cell->col != col) {
+			cell = NULL;
+		}
+	}
+	return cell;
+}
+
+void ED_findBlankCell(DWORD row, DWORD col, const Sheet* sheet, int* isBlank)
+{
+	/* Check if blank cell by dimension ref */
+	*isBlank = 0;
+	if (sheet->hasDimension) {
+		if (row >= sheet->firstRow && col >= sheet->firstCol &&
+			row <= sheet->lastRow && col <= sheet->lastCol) {
+			*isBlank = 1;
+		}
+	}
+}
+
+const Sheet* ED_loadSheet(unzFile zfile, ZipEntry* entries, SheetShare* iter,
+	ED_PARSE_SHEET_FUNC parseSheet, ED_LOCALE_TYPE loc, const char* fileName)
+{
+	if (iter->sheet == NULL && iter->rc == 0 && iter->sheetPath != NULL) {
+		iter->rc = parseSheet(zfile, entries, iter->sheetPath, loc, &iter->sheet);
+	}
+	switch (iter->rc) {
+		case 0:
+			break;
+		case E_NO_MEMORY:
+			ModelicaError("Memory allocation error\n");
+			break;
+		case E_ELOCATE:
+			ModelicaFormatError("Cannot locate %s in file \"%s\"\n", iter->sheetPath, fileName);
+			break;
+		case E_EOPEN:
+			ModelicaFormatError("Cannot open %s in file \"%s\"\n", iter->sheetPath, fileName);
+			break;
+		case E_EREAD:
+			ModelicaFormatError("Cannot read file %s in file \"%s\"\n", iter->sheetPath, fileName);
+			break;
+		default:
+			ModelicaFormatError("Cannot parse file %s of file \"%s\"\n", iter->sheetPath, fileName);
+			break;
+	}
+	return iter->sheet;
+}
+
+const SheetCell* ED_getSheetCell(const Sheet* sheet, DWORD row, DWORD col,
+	const char* sheetName, const char* fileName)
+{
+	const SheetCell* cell = NULL;
+	if (sheet->hasSheetData) {
+		cell = ED_findSheetCell(sheet, row, col);
+	}
+	else {
+		ModelicaFormatError("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+			sheetName, fileName);
+	}
+	return cell;
+}
+
+const char* ED_getCellText(const Sheet* sheet, const SheetCell* cell,
+	ED_SHARED_STRINGS_FUNC findSharedStrings, void* file)
+{
+	const char* token = NULL;
+	if (cell == NULL) {
+		return NULL;
+	}
+	if (cell->type == CELL_SHARED_STRING) {
+		const SharedStrings* sst = findSharedStrings(file);
+		if (sst != NULL && cell->value.sst < sst->count) {
+			token = sst->data + sst->offsets[cell->value.sst];
+		}
+	}
+	else {
+		token = sheet->text + cell->text;
+	}
+	return token;
+}
+
+void ED_logMissingCell(const Sheet* sheet, DWORD row, DWORD col, int* exist,
+	ED_LOGGING_FUNC log, const char* sheetName, const char* fileName)
+{
+	ED_findBlankCell(row, col, sheet, exist);
+	if (*exist == 1) {
+		log("Found blank cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
+			(unsigned int)row, (unsigned int)col, sheetName, fileName);
+	}
+	else {
+		log("Cannot get cell (%u,%u) in sheet \"%s\" from file \"%s\"\n",
+			(unsigned int)row, (unsigned int)col, sheetName, fileName);
+	}
+}
+
+void ED_getDoubleArray2DFromSheet(const Sheet* sheet, DWORD row, DWORD col, double* a,
+	size_t m, size_t n, ED_SHARED_STRINGS_FUNC findSharedStrings, void* file,
+	ED_LOCALE_TYPE loc, ED_LOGGING_FUNC log, const char* sheetName, const char* fileName)
+{
+	size_t i, j;
+	const SheetRow* iter;
+	const SheetRow* rowsEnd = sheet->rows + sheet->nRows;
+	if (!sheet->hasSheetData) {
+		ModelicaFormatError("Cannot find \"sheetData\" in sheet \"%s\" from file \"%s\"\n",
+			sheetName, fileName);
+		return;
+	}
+	iter = ED_lowerBoundRow(sheet, row);
+	for (i = 0; i < m; i++) {
+		const SheetCell* next = NULL;
+		const SheetCell* cellsEnd = NULL;
+		while (iter != rowsEnd && iter->row < row + i) {
+			iter++;
+		}
+		if (iter != rowsEnd && iter->row == row + i) {
+			next = ED_lowerBoundCell(sheet, iter, col);
+			cellsEnd = sheet->cells + iter->first + iter->count;
+		}
+		for (j = 0; j < n; j++) {
+			const SheetCell* cell = NULL;
+			const char* token;
+			if (next != NULL) {
+				while (next != cellsEnd && next->col < col + j) {
+					next++;
+				}
+				if (next != cellsEnd && next->col == col + j) {
+					cell = next;
+				}
+			}
+			if (cell != NULL && cell->type == CELL_NUMBER) {
+				a[i*n + j] = cell->value.number;
+			}
+			else if (NULL != (token = ED_getCellText(sheet, cell, findSharedStrings, file))) {
+				if (ED_strtod((char*)token, loc, &a[i*n + j], ED_STRICT)) {
+					ModelicaFormatError("Error in cell (%u,%u) when reading double value \"%s\" from sheet \"%s\" of file \"%s\"\n",
+						(unsigned int)(row + i), (unsigned int)(col + j), token, sheetName, fileName);
+				}
+			}
+			else {
+				int exist;
+				a[i*n + j] = 0.;
+				ED_logMissingCell(sheet, (DWORD)(row + i), (DWORD)(col + j), &exist, log, sheetName, fileName);
+			}
+		}
+	}
+}
+
+void ED_getArray2DDimensionsFromSheet(const Sheet* sheet, int* m, int* n)
+{
+	if (sheet->hasDimension) {
+		*m = (int)sheet->lastRow + 1;
+		*n = (int)sheet->lastCol + 1;
+	}
+}
+
+void ED_freeSheetShares(SheetShare** sheets)
+{
+	SheetShare* iter;
+	SheetShare* tmp;
+	HASH_ITER(hh, *sheets, iter, tmp) {
+		free(iter->sheetName);
+		free(iter->sheetPath);
+		ED_freeSheet(iter->sheet);
+		HASH_DEL(*sheets, iter);
+		free(iter);
+	}
+}
+
+void ED_freeSharedStrings(SharedStrings* sst)
+{
+	free(sst->data);
+	free(sst->offsets);
+	memset(sst, 0, sizeof(SharedStrings));
+}
+
+typedef struct {
+	const char* fileName;
+	ZipEntry* entries;
+	ED_PARSE_SHEET_FUNC parseSheet;
+	ED_LOCALE_TYPE loc;
+	SheetShare** jobs;
+	unzFile* zfiles; /* Separate zip reader per worker thread */
+} Preload;
+
+static void preloadSheet(void* data, size_t thread, size_t job)
+{
+	Preload* preload = (Preload*)data;
+	SheetShare* iter = preload->jobs[job];
+	if (preload->zfiles[thread] == NULL) {
+		preload->zfiles[thread] = unzOpen64(preload->fileName);
+	}
+	if (preload->zfiles[thread] != NULL && iter->sheetPath != NULL) {
+		/* The error is raised when the sheet is accessed. If the zip file
+		   cannot be opened by the worker, the sheet is parsed on access. */
+		iter->rc = preload->parseSheet(preload->zfiles[thread], preload->entries, iter->sheetPath, preload->loc, &iter->sheet);
+	}
+}
+
+void ED_preloadSheets(const char* fileName, ZipEntry* entries, SheetShare* sheets,
+	const char** sheetNames, size_t nSheetNames, ED_PARSE_SHEET_FUNC parseSheet,
+	ED_LOCALE_TYPE loc, ED_LOGGING_FUNC log, const char* wbName)
+{
+	Preload preload;
+	size_t nJobs = 0;
+	size_t nThreads;
+	size_t i, j;
+	preload.fileName = fileName;
+	preload.entries = entries;
+	preload.parseSheet = parseSheet;
+	preload.loc = loc;
+	preload.jobs = (SheetShare**)malloc((nSheetNames > 0 ? nSheetNames : HASH_COUNT(sheets) + 1)*sizeof(SheetShare*));
+	if (preload.jobs == NULL) {
+		return;
+	}
+	if (nSheetNames > 0) {
+		for (i = 0; i < nSheetNames; i++) {
+			SheetShare* iter;
+			HASH_FIND_STR(sheets, sheetNames[i], iter);
+			if (iter == NULL) {
+				log("Cannot find sheet name \"%s\" in file \"%s\" of file \"%s\"\n",
+					sheetNames[i], wbName, fileName);
+				continue;
+			}
+			for (j = 0; j < nJobs; j++) {
+				if (preload.jobs[j] == iter) {
+					break;
+				}
+			}
+			if (j == nJobs) {
+				preload.jobs[nJobs++] = iter;
+			}
+		}
+	}
+	else {
+		SheetShare* iter;
+		SheetShare* tmp;
+		HASH_ITER(hh, sheets, iter, tmp) {
+			preload.jobs[nJobs++] = iter;
+		}
+	}
+	nThreads = ED_getNumberOfThreads(nJobs);
+	preload.zfiles = (unzFile*)calloc(nThreads, sizeof(unzFile));
+	if (preload.zfiles != NULL) {
+		ED_parallelFor(preloadSheet, &preload, nJobs, nThreads);
+		for (i = 0; i < nThreads; i++) {
+			if (preload.zfiles[i] != NULL) {
+				unzClose(preload.zfiles[i]);
+			}
+		}
+		free(preload.zfiles);
+	}
+	free(preload.jobs);
+}
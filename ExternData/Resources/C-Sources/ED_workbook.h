@@ -0,0 +1,191 @@
+/* ED_workbook.h - Zip package and cell grid functions shared by XLSX and XLSB
+ *
+ * Copyright (C) 2015-2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if !defined(ED_WORKBOOK_H)
+#define ED_WORKBOOK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ED_locale.h"
+#include "ED_logging.h"
+#include "expat.h"
+#include "unzip.h"
+#define HASH_NONFATAL_OOM 1
+#include "uthash.h"
+
+#define E_END_OF_STREAM (-1)
+#define E_NO_MEMORY (11)
+#define E_BAD_DATA (12)
+#define E_EOPEN (15)
+#define E_ECLOSE (17)
+#define E_EREAD (18)
+#define E_ELOCATE (30)
+#define E_EGETFILEINFO (31)
+
+#define READ_BUFFER_SIZE (65536)
+
+typedef uint32_t DWORD;
+
+enum {
+	CELL_NUMBER = 0, /* Numeric or boolean cell, pre-parsed */
+	CELL_SHARED_STRING, /* Index into the shared strings table */
+	CELL_STRING /* Inline string, formula string or error value */
+};
+
+typedef struct {
+	DWORD col;
+	unsigned char type;
+	union {
+		double number;
+		size_t sst;
+	} value;
+	size_t text; /* Offset of the stored value text in Sheet.text, if any */
+} SheetCell;
+
+typedef struct {
+	DWORD row;
+	size_t first; /* Index of first cell of the row in Sheet.cells */
+	size_t count;
+} SheetRow;
+
+typedef struct {
+	SheetRow* rows; /* Sorted by row */
+	size_t nRows;
+	SheetCell* cells; /* Sorted by column within each row */
+	size_t nCells;
+	DWORD* rowIndex; /* Row -> position in rows plus one, zero if missing */
+	size_t nRowIndex;
+	char* text; /* Null-terminated value texts, back to back */
+	size_t textSize;
+	int hasSheetData;
+	int hasDimension;
+	DWORD firstRow, firstCol, lastRow, lastCol; /* Zero-based dimension ref */
+} Sheet;
+
+/* Appends rows, cells and texts to a sheet while it is parsed */
+typedef struct {
+	Sheet* sheet;
+	size_t rowsCapacity;
+	size_t cellsCapacity;
+	size_t textCapacity;
+	SheetRow* row; /* Current row or NULL */
+} SheetBuilder;
+
+typedef struct {
+	char* name;
+	unz64_file_pos pos;
+	UT_hash_handle hh; /* Hashable structure */
+} ZipEntry;
+
+typedef struct {
+	char* sheetName;
+	char* sheetPath; /* Resolved from the workbook relationships */
+	Sheet* sheet;
+	int rc; /* Error code of a failed parse, raised on each access */
+	UT_hash_handle hh; /* Hashable structure */
+} SheetShare;
+
+typedef struct {
+	char* data; /* Null-terminated UTF-8 strings, back to back */
+	size_t size;
+	size_t capacity;
+	size_t* offsets; /* Offset of each string in data */
+	size_t count;
+	size_t offsetsCapacity;
+	int loaded;
+} SharedStrings;
+
+typedef struct {
+	char* id;
+	char* target;
+} Relationship;
+
+typedef struct {
+	XML_Parser parser;
+	Relationship* rels;
+	size_t count;
+	size_t capacity;
+	int rc;
+} RelsParser;
+
+/* Loads the shared strings on first access */
+typedef const SharedStrings* (*ED_SHARED_STRINGS_FUNC)(void* file);
+
+/* Parses the sheet at sheetPath, see ED_preloadSheets */
+typedef int (*ED_PARSE_SHEET_FUNC)(unzFile zfile, ZipEntry* entries, const char* sheetPath, ED_LOCALE_TYPE loc, Sheet** sheet);
+
+/* Zero-based row and column of a cell address like "B3" */
+void ED_rc(const char* cellAddress, DWORD* row, DWORD* col);
+
+/* Hash the zip entry names once instead of scanning them on each lookup */
+int ED_readCentralDirectory(unzFile zfile, ZipEntry** entries);
+void ED_freeCentralDirectory(ZipEntry** entries);
+int ED_locateFile(unzFile zfile, ZipEntry* entries, const char* fileName);
+
+/* Inflate a zip entry chunk-wise straight into the buffer of an expat parser */
+int ED_streamXML(unzFile zfile, ZipEntry* entries, const char* fileName, XML_Parser parser);
+
+const char* ED_localName(const XML_Char* name);
+const char* ED_findAttribute(const XML_Char** atts, const char* name);
+
+/* Workbook relationships */
+int ED_parseRels(unzFile zfile, ZipEntry* entries, const char* fileName, RelsParser* rp);
+void ED_freeRels(RelsParser* rp);
+char* ED_resolveSheetPath(const RelsParser* rp, const char* sheetId);
+
+/* Sheet construction: ED_nextSheetCell returns the slot of the next cell of
+   the current row (or NULL), that is only kept by ED_commitSheetCell. Texts
+   are written to the space returned by ED_reserveSheetText and attached to
+   the cell by ED_commitSheetText. */
+int ED_addSheetRow(SheetBuilder* sb, DWORD row);
+int ED_nextSheetCell(SheetBuilder* sb, SheetCell** cell);
+void ED_commitSheetCell(SheetBuilder* sb);
+char* ED_reserveSheetText(SheetBuilder* sb, size_t len);
+void ED_commitSheetText(SheetBuilder* sb, SheetCell* cell, size_t len);
+
+/* Sorts rows and cells, if needed, and builds the row index */
+void ED_indexSheet(Sheet* sheet);
+void ED_freeSheet(Sheet* sheet);
+
+const SheetRow* ED_lowerBoundRow(const Sheet* sheet, DWORD row);
+const SheetCell* ED_lowerBoundCell(const Sheet* sheet, const SheetRow* iter, DWORD col);
+const SheetCell* ED_findSheetCell(const Sheet* sheet, DWORD row, DWORD col);
+void ED_findBlankCell(DWORD row, DWORD col, const Sheet* sheet, int* isBlank);
+
+/* Cell access of the getters: ED_getSheetCell raises an error if the sheet
+   has no sheet data, ED_getCellText returns the text of a string cell (or
+   the stored value text of a numeric XLSX cell) and ED_logMissingCell
+   reports a cell without value. */
+const SheetCell* ED_getSheetCell(const Sheet* sheet, DWORD row, DWORD col,
+	const char* sheetName, const char* fileName);
+const char* ED_getCellText(const Sheet* sheet, const SheetCell* cell,
+	ED_SHARED_STRINGS_FUNC findSharedStrings, void* file);
+void ED_logMissingCell(const Sheet* sheet, DWORD row, DWORD col, int* exist,
+	ED_LOGGING_FUNC log, const char* sheetName, const char* fileName);
+
+/* Reads the m x n range starting at (row, col) row-wise into a, walking the
+   rows and cells of the range in storage order */
+void ED_getDoubleArray2DFromSheet(const Sheet* sheet, DWORD row, DWORD col, double* a,
+	size_t m, size_t n, ED_SHARED_STRINGS_FUNC findSharedStrings, void* file,
+	ED_LOCALE_TYPE loc, ED_LOGGING_FUNC log, const char* sheetName, const char* fileName);
+void ED_getArray2DDimensionsFromSheet(const Sheet* sheet, int* m, int* n);
+
+/* Parses the sheet on first access unless preloaded, raises parse errors */
+const Sheet* ED_loadSheet(unzFile zfile, ZipEntry* entries, SheetShare* iter,
+	ED_PARSE_SHEET_FUNC parseSheet, ED_LOCALE_TYPE loc, const char* fileName);
+void ED_freeSheetShares(SheetShare** sheets);
+void ED_freeSharedStrings(SharedStrings* sst);
+
+/* Decode all or the listed sheets in parallel, each worker thread with a
+   separate zip reader. Parse errors are kept per sheet and raised by
+   ED_loadSheet, sheets not decoded are parsed on first access. */
+void ED_preloadSheets(const char* fileName, ZipEntry* entries, SheetShare* sheets,
+	const char** sheetNames, size_t nSheetNames, ED_PARSE_SHEET_FUNC parseSheet,
+	ED_LOCALE_TYPE loc, ED_LOGGING_FUNC log, const char* wbName);
+
+#endif
@@ -34,6 +34,19 @@
 #define XMLTREE_CHILDSIZE   8
 #define XMLTREE_ATTRSIZE    4
 #define XMLTREE_STACKSIZE   32
+/* file read chunk size */
+#define XMLTREE_READSIZE    65536
+/* min. number of childs for tag index */
+#define XMLTREE_INDEXMIN    8
+/* arena block and intern table size */
+#define XMLARENA_BLOCKSIZE  65536
+#define XMLARENA_STRSIZE    64
+
+#define XMLARENA_ALIGN(n) \
+    (((n) + sizeof(void*) - 1) & ~(sizeof(void*) - 1))
+
+#define XMLARENA_DATA(block) \
+    ((char*)(block) + XMLARENA_ALIGN(sizeof(XmlArenaBlock)))
 
 #define ENC_TYPE_UTF8   "UTF-8"
 
@@ -49,6 +62,235 @@
 #define isAlphaNumeric(c) \
     (isDigit(c) || isAlpha(c))
 
+/* open addressing hash of child tags, slots hold the child position + 1 of
+   the first child with that tag, 0 marks an empty slot */
+struct XmlTagIndex {
+    asize_t num;
+    asize_t used;
+    asize_t size;
+    asize_t *slots;
+};
+
+/* bump allocator backing a parsed tree, freed as a whole with the root */
+typedef struct XmlArenaBlock XmlArenaBlock;
+struct XmlArenaBlock {
+    XmlArenaBlock *prev;
+    size_t size;
+    size_t used;
+};
+
+struct XmlArena {
+    XmlArenaBlock *block;
+    /* last allocation, can be extended in place */
+    char *last;
+    /* interned tags and attribute keys (open addressing) */
+    String *strings;
+    asize_t numStrings;
+    asize_t sizeStrings;
+    /* shared by all nodes without childs or attributes */
+    XmlNodes empty;
+};
+
+static size_t XmlString_hash(const char *s)
+{
+    /* FNV-1a */
+    size_t h = 2166136261u;
+    while (*s != '\0') {
+        h = (h ^ (unsigned char)*s++) * 16777619u;
+    }
+    return h;
+}
+
+static XmlArena *XmlArena_create(void)
+{
+    XmlArena *arena = (XmlArena *)calloc(1, sizeof(XmlArena));
+    if (arena == NULL) return NULL;
+    arena->strings = (String *)calloc(XMLARENA_STRSIZE, sizeof(String));
+    if (arena->strings == NULL) {
+        free(arena);
+        return NULL;
+    }
+    arena->sizeStrings = XMLARENA_STRSIZE;
+    return arena;
+}
+
+static void XmlArena_destroy(XmlArena *arena)
+{
+    XmlArenaBlock *block = arena->block;
+    while (block != NULL) {
+        XmlArenaBlock *prev = block->prev;
+        free(block);
+        block = prev;
+    }
+    free(arena->strings);
+    free(arena);
+}
+
+static XmlArenaBlock *XmlArena_addBlock(XmlArena *arena, size_t size)
+{
+    XmlArenaBlock *block;
+    if (size < XMLARENA_BLOCKSIZE) {
+        size = XMLARENA_BLOCKSIZE;
+    }
+    block = (XmlArenaBlock *)malloc(XMLARENA_ALIGN(sizeof(XmlArenaBlock)) + size);
+    if (block == NULL) return NULL;
+    block->prev = arena->block;
+    block->size = size;
+    block->used = 0;
+    arena->block = block;
+    return block;
+}
+
+static void *XmlArena_alloc(XmlArena *arena, size_t size)
+{
+    XmlArenaBlock *block = arena->block;
+    size = XMLARENA_ALIGN(size);
+    if (block == NULL || block->used + size > block->size) {
+        block = XmlArena_addBlock(arena, size);
+        if (block == NULL) return NULL;
+    }
+    arena->last = XMLARENA_DATA(block) + block->used;
+    block->used += size;
+    return arena->last;
+}
+
+/* grow an allocation, in place if it is the last one and fits */
+static void *XmlArena_extend(XmlArena *arena, void *ptr, size_t size, size_t newSize)
+{
+    void *newPtr;
+    if (ptr != NULL && ptr == arena->last) {
+        XmlArenaBlock *block = arena->block;
+        size_t offset = (size_t)((char *)ptr - XMLARENA_DATA(block));
+        if (offset + newSize <= block->size) {
+            block->used = XMLARENA_ALIGN(offset + newSize);
+            return ptr;
+        }
+        /* leave room for further growth */
+        if (XmlArena_addBlock(arena, 2*newSize) == NULL) return NULL;
+    }
+    newPtr = XmlArena_alloc(arena, newSize);
+    if (newPtr != NULL && size > 0) {
+        memcpy(newPtr, ptr, size);
+    }
+    return newPtr;
+}
+
+static String XmlArena_strdup(XmlArena *arena, const char *s)
+{
+    size_t len = strlen(s);
+    String str = (String)XmlArena_alloc(arena, len + 1);
+    if (str != NULL) {
+        memcpy(str, s, len + 1);
+    }
+    return str;
+}
+
+static String XmlArena_intern(XmlArena *arena, const char *s)
+{
+    asize_t mask = arena->sizeStrings - 1;
+    asize_t i = XmlString_hash(s) & mask;
+    while (arena->strings[i] != NULL) {
+        if (strcmp(arena->strings[i], s) == 0) {
+            return arena->strings[i];
+        }
+        i = (i + 1) & mask;
+    }
+
+    if (2*(arena->numStrings + 1) > arena->sizeStrings) {
+        asize_t j;
+        asize_t newSize = 2*arena->sizeStrings;
+        String *strings = (String *)calloc(newSize, sizeof(String));
+        if (strings == NULL) return NULL;
+        for (j = 0; j < arena->sizeStrings; j++) {
+            if (arena->strings[j] != NULL) {
+                asize_t k = XmlString_hash(arena->strings[j]) & (newSize - 1);
+                while (strings[k] != NULL) {
+                    k = (k + 1) & (newSize - 1);
+                }
+                strings[k] = arena->strings[j];
+            }
+        }
+        free(arena->strings);
+        arena->strings = strings;
+        arena->sizeStrings = newSize;
+        mask = newSize - 1;
+        i = XmlString_hash(s) & mask;
+        while (arena->strings[i] != NULL) {
+            i = (i + 1) & mask;
+        }
+    }
+
+    arena->strings[i] = XmlArena_strdup(arena, s);
+    if (arena->strings[i] != NULL) {
+        arena->numStrings++;
+    }
+    return arena->strings[i];
+}
+
+static void *XmlNode_calloc(struct XmlNode *node, size_t size)
+{
+    void *ptr;
+    if (node->m_arena == NULL) {
+        return calloc(1, size);
+    }
+    ptr = XmlArena_alloc(node->m_arena, size);
+    if (ptr != NULL) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+static void XmlNode_free(struct XmlNode *node, void *ptr)
+{
+    if (node->m_arena == NULL) {
+        free(ptr);
+    }
+}
+
+/* append an element to an arena backed array of a node, the array starts
+   with a single element as most nodes have only few childs and attributes */
+static void *XmlArena_push(XmlArena *arena, XmlNodes **array, asize_t elem_size)
+{
+    XmlNodes *a = *array;
+    void *elt;
+    if (a == &arena->empty) {
+        a = (XmlNodes *)XmlArena_alloc(arena, sizeof(XmlNodes));
+        if (a == NULL) return NULL;
+        a->num = 0;
+        a->max = 0;
+        a->v = NULL;
+        a->elem_size = elem_size;
+        a->cmp = NULL;
+        *array = a;
+    }
+
+    if (a->num == a->max) {
+        asize_t newmax = a->max > 0 ? 2*a->max : 1;
+        void *newv = XmlArena_extend(arena, a->v, a->max*elem_size, newmax*elem_size);
+        if (newv == NULL) return NULL;
+        a->v = newv;
+        a->max = newmax;
+    }
+
+    elt = (unsigned char*)a->v + elem_size*a->num++;
+    memset(elt, 0, elem_size);
+    a->cmp = NULL;
+    return elt;
+}
+
+/* childs are stored by value, reset the parent of the grandchilds after the
+   child array moved (except for the just pushed last child) */
+static void XmlNode_updateParents(struct XmlNode *node)
+{
+    asize_t i, j;
+    for (i = 0; i + 1 < node->m_childs->num; i++) {
+        XmlNode *child = (XmlNode *)cpo_array_get_at(node->m_childs, i);
+        for (j = 0; j < child->m_childs->num; j++) {
+            ((XmlNode *)cpo_array_get_at(child->m_childs, j))->m_parent = child;
+        }
+    }
+}
+
 XmlNode * XmlNode_Create(const String tag)
 {
     XmlNode * node = (XmlNode *) malloc( sizeof(struct XmlNode) );
@@ -57,6 +299,8 @@ XmlNode * XmlNode_Create(const String tag)
     node->m_type = NODE_ROOT;
     node->m_parent = 0;
     node->m_content = NULL;
+    node->m_tagIndex = NULL;
+    node->m_arena = NULL;
     node->m_childs = cpo_array_create(XMLTREE_CHILDSIZE, sizeof(struct XmlNode));
     node->m_attributes = cpo_array_create(XMLTREE_ATTRSIZE, sizeof( struct XmlAttribute) );
     return node;
@@ -105,7 +349,7 @@ void XmlNode_setLine(struct XmlNode * node, int line )
 void XmlNode_delete(struct XmlNode *node)
 {
     asize_t i;
-    if (node == NULL) return;
+    if (node == NULL || node->m_arena != NULL) return;
     //printf("delete %s\n", node->m_tag);
     for (i=0; i < node->m_attributes->num; i++) {
         XmlAttribute *attr = cpo_array_get_at(node->m_attributes, i);
@@ -124,6 +368,11 @@ void XmlNode_delete(struct XmlNode *node)
     if (node->m_content)
         free(node->m_content);
 
+    if (node->m_tagIndex) {
+        free(node->m_tagIndex->slots);
+        free(node->m_tagIndex);
+    }
+
     free(node->m_tag);
 }
 
@@ -131,6 +380,14 @@ void XmlNode_deleteTree(struct XmlNode *root)
 {
     asize_t i;
     if (root == NULL) return;
+    if (root->m_arena != NULL) {
+        /* the root owns the arena of a parsed tree */
+        if (root->m_type == NODE_ROOT) {
+            XmlArena_destroy(root->m_arena);
+        }
+        return;
+    }
+
     for (i=0 ; i < root->m_childs->num; i++) {
         XmlNode *node = cpo_array_get_at(root->m_childs, i);
         XmlNode_deleteTree(node);
@@ -189,42 +446,148 @@ int XmlNode_haveAttribute(struct XmlNode *node, const String key )
 
 void XmlNode_setAttribute(struct XmlNode *node, const String key, const String value )
 {
-    XmlAttribute *a = (XmlAttribute *)cpo_array_push( node->m_attributes );
+    XmlAttribute *a;
+    if (node->m_arena != NULL) {
+        a = (XmlAttribute *)XmlArena_push(node->m_arena, &node->m_attributes, sizeof(struct XmlAttribute));
+        if (a == NULL) return;
+        a->key = XmlArena_intern(node->m_arena, key);
+        a->value = XmlArena_strdup(node->m_arena, value);
+        return;
+    }
+
+    a = (XmlAttribute *)cpo_array_push( node->m_attributes );
     a->key =  strdup(key);
     a->value =  strdup(value);
 }
 
-static int XmlNode_comparer(const void *a, const void *b)
+static asize_t *XmlTagIndex_find(XmlTagIndex *index, XmlNodes *childs, const char *tag)
 {
-    return strcmp(((XmlNode *) a)->m_tag, ((XmlNode *) b)->m_tag);
+    asize_t mask = index->size - 1;
+    asize_t i = XmlString_hash(tag) & mask;
+    while (index->slots[i] != 0) {
+        XmlNode *child = (XmlNode *)cpo_array_get_at(childs, index->slots[i] - 1);
+        if (strcmp(child->m_tag, tag) == 0) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return &index->slots[i];
+}
+
+static int XmlTagIndex_grow(struct XmlNode *node)
+{
+    asize_t i;
+    XmlTagIndex *index = node->m_tagIndex;
+    XmlNodes *childs = node->m_childs;
+    asize_t *slots = index->slots;
+    asize_t size = index->size;
+    asize_t newSize = size > 0 ? 2*size : 2*XMLTREE_INDEXMIN;
+    index->slots = (asize_t *)XmlNode_calloc(node, newSize*sizeof(asize_t));
+    if (index->slots == NULL) {
+        index->slots = slots;
+        return ENOMEM;
+    }
+    index->size = newSize;
+    for (i = 0; i < size; i++) {
+        if (slots[i] != 0) {
+            XmlNode *child = (XmlNode *)cpo_array_get_at(childs, slots[i] - 1);
+            *XmlTagIndex_find(index, childs, child->m_tag) = slots[i];
+        }
+    }
+    XmlNode_free(node, slots);
+    return 0;
+}
+
+static XmlTagIndex *XmlNode_getTagIndex(struct XmlNode *node)
+{
+    XmlTagIndex *index = node->m_tagIndex;
+    if (index == NULL) {
+        index = (XmlTagIndex *)XmlNode_calloc(node, sizeof(XmlTagIndex));
+        if (index == NULL) return NULL;
+        node->m_tagIndex = index;
+    }
+
+    /* childs are only appended, index the ones added since the last call */
+    while (index->num < node->m_childs->num) {
+        XmlNode *child = (XmlNode *)cpo_array_get_at(node->m_childs, index->num);
+        asize_t *slot;
+        if (2*(index->used + 1) > index->size && XmlTagIndex_grow(node) != 0) {
+            return NULL;
+        }
+        slot = XmlTagIndex_find(index, node->m_childs, child->m_tag);
+        if (*slot == 0) {
+            *slot = index->num + 1;
+            index->used++;
+        }
+        index->num++;
+    }
+    return index;
 }
 
 XmlNodeRef XmlNode_findChild(struct XmlNode *node, const String tag )
 {
-    XmlNode tmpNode = {NODE_CHILD, 0, (String)tag};
-    XmlNodeRef ret = (XmlNodeRef)cpo_array_bsearch(node->m_childs, &tmpNode, XmlNode_comparer);
-    return ret;
+    asize_t i;
+    if (node->m_childs->num >= XMLTREE_INDEXMIN) {
+        XmlTagIndex *index = XmlNode_getTagIndex(node);
+        if (index != NULL) {
+            asize_t pos = *XmlTagIndex_find(index, node->m_childs, tag);
+            return pos != 0 ? (XmlNodeRef)cpo_array_get_at(node->m_childs, pos - 1) : NULL;
+        }
+    }
+
+    for (i = 0; i < node->m_childs->num; i++) {
+        XmlNodeRef child = (XmlNodeRef)cpo_array_get_at(node->m_childs, i);
+        if (strcmp(child->m_tag, tag) == 0) {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+static XmlNodeRef XmlNode_pushChild(struct XmlNode *node)
+{
+    XmlNodeRef child;
+    void *v = node->m_childs->v;
+    if (node->m_arena != NULL) {
+        child = (XmlNodeRef)XmlArena_push(node->m_arena, &node->m_childs, sizeof(struct XmlNode));
+    } else {
+        child = (XmlNodeRef)cpo_array_push( node->m_childs );
+    }
+
+    if (child != NULL && v != NULL && node->m_childs->v != v) {
+        XmlNode_updateParents(node);
+    }
+    return child;
 }
 
 XmlNode * XmlNode_createChild(struct XmlNode *node, const String tag, const String text)
 {
-    XmlNodeRef child = (XmlNodeRef)cpo_array_push( node->m_childs );
-    child->m_tag = strdup( tag );
+    XmlNodeRef child = XmlNode_pushChild(node);
+    if (child == NULL) return NULL;
     child->m_type = NODE_CHILD;
     child->m_content = NULL;
+    child->m_tagIndex = NULL;
+    child->m_arena = node->m_arena;
     child->m_parent = node;
+    if (node->m_arena != NULL) {
+        child->m_tag = XmlArena_intern(node->m_arena, tag);
+        child->m_childs = &node->m_arena->empty;
+        child->m_attributes = &node->m_arena->empty;
+    } else {
+        child->m_tag = strdup( tag );
+        child->m_childs = cpo_array_create(XMLTREE_CHILDSIZE , sizeof(struct XmlNode));
+        child->m_attributes = cpo_array_create(XMLTREE_ATTRSIZE , sizeof( struct XmlAttribute) );
+    }
+
     if (text) {
         XmlNode_setValue(child, text );
     }
-
-    child->m_childs = cpo_array_create(XMLTREE_CHILDSIZE , sizeof(struct XmlNode));
-    child->m_attributes = cpo_array_create(XMLTREE_ATTRSIZE , sizeof( struct XmlAttribute) );
     return child;
 }
 
 void XmlNode_addChild(struct XmlNode *node, const XmlNodeRef child )
 {
-    XmlNodeRef ref = (XmlNodeRef)cpo_array_push( node->m_childs );
+    XmlNodeRef ref = XmlNode_pushChild(node);
     if (ref) {
         *ref = *child;
         ref->m_parent = node;
@@ -271,7 +634,9 @@ void XmlNode_setValue(struct XmlNode *node, const String value )
             size_t end = strlen(node->m_content);
             size_t len = strlen(value);
             unsigned last = isAlphaNumeric(*(node->m_content + end-1)) ? 2:1;
-            char *new = realloc(node->m_content,(end + len + last));
+            char *new = node->m_arena != NULL ?
+                (char*)XmlArena_extend(node->m_arena, node->m_content, end + 1, end + len + last) :
+                realloc(node->m_content,(end + len + last));
             if (new == NULL) return;
             node->m_content = new;
 
@@ -280,6 +645,8 @@ void XmlNode_setValue(struct XmlNode *node, const String value )
                 end+=1;
             }
             strncpy(node->m_content + end, value, len+1);
+        } else if (node->m_arena != NULL) {
+            node->m_content = XmlArena_strdup(node->m_arena, value);
         } else {
             node->m_content = strdup(value);
         }
@@ -452,18 +819,71 @@ void XmlNode_toFile(struct XmlNode *node, const char *fileName)
     }
 }
 /*parser */
+
+/* character data of an open element, collected until the element ends */
+struct XmlText {
+    char *buf;
+    size_t len;
+    size_t size;
+    /* whitespace or a child element was skipped since the last data */
+    int sep;
+};
+
+static XmlText *XmlParser_getText(XmlParser *parser)
+{
+    asize_t depth = parser->m_nodeStack->num - 1;
+    if (depth >= parser->m_textSize) {
+        asize_t newSize = parser->m_textSize > 0 ? 2*parser->m_textSize : XMLTREE_STACKSIZE;
+        XmlText *text;
+        while (depth >= newSize) {
+            newSize *= 2;
+        }
+        text = (XmlText *)realloc(parser->m_text, newSize*sizeof(XmlText));
+        if (text == NULL) return NULL;
+        memset(text + parser->m_textSize, 0, (newSize - parser->m_textSize)*sizeof(XmlText));
+        parser->m_text = text;
+        parser->m_textSize = newSize;
+    }
+    return &parser->m_text[depth];
+}
+
+static void XmlParser_freeText(XmlParser *parser)
+{
+    asize_t i;
+    for (i = 0; i < parser->m_textSize; i++) {
+        free(parser->m_text[i].buf);
+    }
+    free(parser->m_text);
+    parser->m_text = NULL;
+    parser->m_textSize = 0;
+}
+
 static void startElement(void *userData, const char *name, const char **atts)
 {
     asize_t i = 0;
     void *ptr = NULL;
     XmlNodeRef parent= NULL, node=NULL;
     XmlParser *parser = (XmlParser *)userData;
+    XmlText *text;
 
     if (parser->m_nodeStack->num > 0) {
         ptr = stack_back(parser->m_nodeStack);
         parent = (XmlNodeRef) ARR_VAL(ptr);
+        /* separate the text before and after the child */
+        text = XmlParser_getText(parser);
+        if (text != NULL) {
+            text->sep = 1;
+        }
     } else {
-        parser->m_root = XmlNode_Create((const String) name);
+        parser->m_root = (XmlNodeRef)XmlArena_alloc(parser->m_arena, sizeof(struct XmlNode));
+        if (parser->m_root != NULL) {
+            memset(parser->m_root, 0, sizeof(struct XmlNode));
+            parser->m_root->m_type = NODE_ROOT;
+            parser->m_root->m_arena = parser->m_arena;
+            parser->m_root->m_tag = XmlArena_intern(parser->m_arena, name);
+            parser->m_root->m_childs = &parser->m_arena->empty;
+            parser->m_root->m_attributes = &parser->m_arena->empty;
+        }
     }
 
     if (parent) {
@@ -472,18 +892,56 @@ static void startElement(void *userData, const char *name, const char **atts)
         node = parser->m_root;
     }
 
-    ptr = stack_push_back(parser->m_nodeStack);
-    if (ptr != NULL) {
-        ARR_VAL(ptr) = ARR_VAL2PTR(node);
+    if (node == NULL || node->m_tag == NULL) {
+        XML_StopParser(parser->m_parser, XML_FALSE);
+        return;
     }
 
+    ptr = cpo_array_push(parser->m_nodeStack);
+    if (ptr == NULL) {
+        XML_StopParser(parser->m_parser, XML_FALSE);
+        return;
+    }
+    ARR_VAL(ptr) = ARR_VAL2PTR(node);
+
+    text = XmlParser_getText(parser);
+    if (text == NULL) {
+        XML_StopParser(parser->m_parser, XML_FALSE);
+        return;
+    }
+    text->len = 0;
+    text->sep = 0;
+
     XmlNode_setLine(node, XML_GetCurrentLineNumber( parser->m_parser ) );
 
     // Call start element callback.
     while (atts[i] != 0) {
-        XmlNode_setAttribute(node, (const String)atts[i], (const String)atts[i+1] );
         i += 2;
     }
+
+    if (i > 0) {
+        /* the number of attributes is known, allocate them at once */
+        XmlAttributes *attributes = (XmlAttributes *)XmlArena_alloc(parser->m_arena, sizeof(XmlAttributes));
+        if (attributes == NULL) {
+            XML_StopParser(parser->m_parser, XML_FALSE);
+            return;
+        }
+        attributes->num = 0;
+        attributes->max = i/2;
+        attributes->elem_size = sizeof(struct XmlAttribute);
+        attributes->cmp = NULL;
+        attributes->v = XmlArena_alloc(parser->m_arena, attributes->max*sizeof(struct XmlAttribute));
+        if (attributes->v == NULL) {
+            XML_StopParser(parser->m_parser, XML_FALSE);
+            return;
+        }
+        for (i = 0; atts[i] != 0; i += 2) {
+            XmlAttribute *a = (XmlAttribute *)attributes->v + attributes->num++;
+            a->key = XmlArena_intern(parser->m_arena, atts[i]);
+            a->value = XmlArena_strdup(parser->m_arena, atts[i+1]);
+        }
+        node->m_attributes = attributes;
+    }
 }
 
 static void endElement(void *userData, const char *name )
@@ -492,7 +950,22 @@ static void endElement(void *userData, const char *name )
 
     assert( parser->m_nodeStack->num > 0 );
     if (parser->m_nodeStack->num > 0) {
-        stack_pop_back(parser->m_nodeStack);
+        XmlText *text = XmlParser_getText(parser);
+        if (text != NULL && text->len > 0) {
+            XmlNode *node = (XmlNode*) ARR_VAL(stack_back(parser->m_nodeStack));
+            text->buf[text->len] = '\0';
+            if (node->m_content == NULL) {
+                node->m_content = (String)XmlArena_alloc(parser->m_arena, text->len + 1);
+                if (node->m_content == NULL) {
+                    XML_StopParser(parser->m_parser, XML_FALSE);
+                    return;
+                }
+                memcpy(node->m_content, text->buf, text->len + 1);
+            } else {
+                XmlNode_setValue(node, text->buf);
+            }
+        }
+        parser->m_nodeStack->num--;
     }
 }
 
@@ -501,14 +974,45 @@ static void characterData( void *userData, const char *s, int len )
     XmlParser *parser = (XmlParser *)userData;
 
     if (parser->m_nodeStack->num > 0) {
-        void *ptr = stack_back(parser->m_nodeStack);
-        XmlNode *node = (XmlNode*) ARR_VAL(ptr);
-        char *str = (char*)malloc(len + 1);
-        if (!str) return;
-        strncpy(str,s,len);
-        str[len] = 0;
-        XmlNode_setValue(node, str);
-        free(str);
+        XmlText *text = XmlParser_getText(parser);
+        int i;
+        if (text == NULL) return;
+        for (i = 0; i < len; i++) {
+            if (s[i] != ' ' && s[i] != '\r' && s[i] != '\n' && s[i] != '\t') {
+                break;
+            }
+        }
+
+        if (i == len) {
+            /* whitespace only, as in XmlNode_setValue */
+            text->sep = 1;
+            return;
+        }
+
+        /* the same joining as in XmlNode_setValue, but only between data
+           that is separated by whitespace or a child and not between the
+           pieces expat splits a text at (buffer ends, entities) */
+        if (text->len + len + 2 > text->size) {
+            size_t newSize = text->size > 0 ? 2*text->size : 256;
+            char *buf;
+            while (text->len + len + 2 > newSize) {
+                newSize *= 2;
+            }
+            buf = (char*)realloc(text->buf, newSize);
+            if (buf == NULL) {
+                XML_StopParser(parser->m_parser, XML_FALSE);
+                return;
+            }
+            text->buf = buf;
+            text->size = newSize;
+        }
+
+        if (text->sep && text->len > 0 && isAlphaNumeric(text->buf[text->len - 1])) {
+            text->buf[text->len++] = ' ';
+        }
+        memcpy(text->buf + text->len, s, len);
+        text->len += len;
+        text->sep = 0;
     }
 }
 
@@ -533,19 +1037,48 @@ XmlNodeRef XmlParser_parse(XmlParser *parser,  const char * xml)
     return XmlParser_parse_ns(parser, xml, '\0');
 }
 
-XmlNodeRef XmlParser_parse_ns(XmlParser *parser,  const char * xml, char ns_sep)
+static int XmlParser_begin(XmlParser *parser, char ns_sep)
 {
-    XmlNodeRef root = NULL;
     parser->m_errorString = NULL;
+    parser->m_errorLine = 0;
+    parser->m_errorLineSet = 0;
+    parser->m_root = NULL;
+    parser->m_text = NULL;
+    parser->m_textSize = 0;
+    parser->m_arena = XmlArena_create();
     parser->m_nodeStack= cpo_array_create(XMLTREE_STACKSIZE, sizeof(void*));
     /*expat parser*/
     parser->m_parser = ns_sep == '\0' ? XML_ParserCreate(NULL) : XML_ParserCreateNS(NULL, ns_sep);
+    if (parser->m_arena == NULL || parser->m_nodeStack == NULL || parser->m_parser == NULL) {
+        if (parser->m_arena != NULL) {
+            XmlArena_destroy(parser->m_arena);
+        }
+        if (parser->m_nodeStack != NULL) {
+            cpo_array_destroy(parser->m_nodeStack);
+        }
+        if (parser->m_parser != NULL) {
+            XML_ParserFree(parser->m_parser);
+        }
+        parser->m_errorString = strerror(ENOMEM);
+        return XML_NOK;
+    }
+
     XML_SetUserData(parser->m_parser, parser );
     XML_SetElementHandler(parser->m_parser, startElement, endElement );
     XML_SetCharacterDataHandler(parser->m_parser, characterData );
+    return XML_OK;
+}
 
-    if (XML_Parse(parser->m_parser, xml, (int)strlen(xml), XML_TRUE)) {
+/* return root elem if parsing succeeded, err is a read error (errno) */
+static XmlNodeRef XmlParser_end(XmlParser *parser, enum XML_Status status, int err)
+{
+    XmlNodeRef root = NULL;
+    if (err != 0) {
+        parser->m_errorString = strerror(err);
+    } else if (status == XML_STATUS_OK) {
         root = parser->m_root;
+    } else if (XML_GetErrorCode(parser->m_parser) == XML_ERROR_ABORTED) {
+        parser->m_errorString = strerror(ENOMEM);
     } else {
         parser->m_errorString = (char*)XML_ErrorString(XML_GetErrorCode(parser->m_parser));
         parser->m_errorLine = XML_GetCurrentLineNumber(parser->m_parser);
@@ -557,9 +1090,23 @@ XmlNodeRef XmlParser_parse_ns(XmlParser *parser,  const char * xml, char ns_sep)
 
     XML_ParserFree(parser->m_parser);
     cpo_array_destroy(parser->m_nodeStack);
+    XmlParser_freeText(parser);
+    if (root == NULL) {
+        XmlArena_destroy(parser->m_arena);
+    }
+    parser->m_arena = NULL;
     return root;
 }
 
+XmlNodeRef XmlParser_parse_ns(XmlParser *parser,  const char * xml, char ns_sep)
+{
+    if (!XmlParser_begin(parser, ns_sep)) {
+        return NULL;
+    }
+
+    return XmlParser_end(parser, XML_Parse(parser->m_parser, xml, (int)strlen(xml), XML_TRUE), 0);
+}
+
 XmlNodeRef XmlParser_parse_file(struct XmlParser *parser,  const String fileName )
 {
     return XmlParser_parse_file_ns(parser, fileName, '\0');
@@ -571,26 +1118,32 @@ XmlNodeRef XmlParser_parse_file_ns(struct XmlParser *parser,  const String fileN
     FILE *f = fopen (fileName, "rb");
 
     if (f != NULL) {
-        char * buffer;
-        long length;
-        size_t read = 0;
-        fseek (f, 0, SEEK_END);
-        length = ftell (f);
-        fseek (f, 0, SEEK_SET);
-        buffer = (char*) malloc (length + 1);
-        if (buffer != NULL) {
-            read = fread (buffer, sizeof(char), length, f);
-            buffer[read] = '\0';
+        /* parse in chunks, only the DOM is kept in memory */
+        enum XML_Status status = XML_STATUS_OK;
+        int err = 0;
+        int isFinal = 0;
+        if (!XmlParser_begin(parser, ns_sep)) {
+            fclose (f);
+            return NULL;
         }
-        fclose (f);
-        if (read == length) {
-            root = XmlParser_parse_ns(parser,  buffer, ns_sep);
-        } else {
-            parser->m_errorString = strerror(errno);
-            parser->m_errorLine = 0;
-            parser->m_errorLineSet = 0;
+
+        while (status == XML_STATUS_OK && !isFinal) {
+            size_t read;
+            void *buffer = XML_GetBuffer(parser->m_parser, XMLTREE_READSIZE);
+            if (buffer == NULL) {
+                err = ENOMEM;
+                break;
+            }
+            read = fread (buffer, sizeof(char), XMLTREE_READSIZE, f);
+            if (ferror (f)) {
+                err = errno != 0 ? errno : EIO;
+                break;
+            }
+            isFinal = feof (f);
+            status = XML_ParseBuffer(parser->m_parser, (int)read, isFinal);
         }
-        free(buffer);
+        fclose (f);
+        root = XmlParser_end(parser, status, err);
     } else {
         parser->m_errorString = strerror(errno);
         parser->m_errorLine = 0;
@@ -50,6 +50,9 @@ typedef struct s_array XmlStack;
 typedef struct s_array XmlNodes;
 typedef struct XmlNode XmlNode;
 typedef struct XmlParser XmlParser;
+typedef struct XmlTagIndex XmlTagIndex;
+typedef struct XmlArena XmlArena;
+typedef struct XmlText XmlText;
 
 struct XmlAttribute {
     String key;
@@ -62,6 +65,9 @@ struct XmlParser
     XML_Parser  m_parser;
     String      m_errorString;
     XmlStack   *m_nodeStack;
+    XmlArena   *m_arena;
+    XmlText    *m_text;
+    asize_t     m_textSize;
     XML_Size    m_errorLine;
     int         m_errorLineSet;
 };
@@ -89,6 +95,10 @@ struct XmlNode {
     XmlNodes *m_childs;
     //! Xml node attributes.
     XmlAttributes *m_attributes;
+    //! Lazily built tag lookup of the child nodes (NULL if not built).
+    XmlTagIndex *m_tagIndex;
+    //! Arena owning the memory of a parsed tree (NULL for heap allocated nodes).
+    XmlArena *m_arena;
 };
 
 /*create root element */
@@ -122,7 +132,7 @@ asize_t XmlNode_getChildCount(struct XmlNode * node);
 //! Get XML Node child nodes.
 XmlNodeRef XmlNode_getChild(struct XmlNode * node, asize_t i );
 
-//! Find node with specified tag.
+//! Find first node (in document order) with specified tag.
 XmlNodeRef XmlNode_findChild(struct XmlNode * node, const String tag );
 
 //! Get parent XML node.
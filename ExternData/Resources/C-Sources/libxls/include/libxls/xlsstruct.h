@@ -64,6 +64,7 @@
 #define XLS_RECORD_EXTSST       0x00FF
 #define XLS_RECORD_TXO          0x01B6
 #define XLS_RECORD_HYPERREF     0x01B8
+#define XLS_RECORD_DIMENSION    0x0200
 #define XLS_RECORD_BLANK        0x0201
 #define XLS_RECORD_NUMBER       0x0203
 #define XLS_RECORD_LABEL        0x0204
@@ -413,9 +414,15 @@ typedef	struct st_sst
     DWORD lastsz;
     struct str_sst_string
     {
-        char * str;
+        char * str;     // Decoded string, NULL until first access
+        DWORD ofs;      // Offset of raw characters in raw
+        DWORD len;      // Character count
+        BYTE is16;      // Raw characters are UTF-16LE (else compressed 8 bit)
     }
     * string;
+    BYTE * raw;         // Raw characters of all strings
+    DWORD rawsize;
+    DWORD rawcap;
 }
 st_sst;
 
@@ -429,7 +436,10 @@ typedef	struct st_cell
         WORD	row;
         WORD	col;
         WORD	xf;
-        char *	str;		// String value;
+        char *	str;		// String value, see xls_cell_get_str for labels;
+        BYTE *	raw;		// Raw label or formula string, decoded on demand
+        DWORD	rawsize;
+        DWORD	sst;		// Index into SST (LABELSST)
         double	d;
         int32_t	l;
         WORD	width;		// Width of col
@@ -478,6 +488,19 @@ typedef	struct st_colinfo
 }
 st_colinfo;
 
+typedef	struct st_rowblock
+{
+    DWORD count;				// Count of row blocks (from INDEX)
+    struct st_rowblock_data
+    {
+        DWORD	dbcell;		// Stream position of DBCELL record
+        DWORD	firstrow;	// First row of row block, 0xFFFFFFFF if not yet read
+        BYTE	isParsed;
+    }
+    * block;
+}
+st_rowblock;
+
 typedef struct xlsWorkBook
 {
     //FILE*		file;
@@ -515,6 +538,7 @@ typedef struct xlsWorkSheet
     st_row		rows;
     xlsWorkBook *workbook;
     st_colinfo	colinfo;
+    st_rowblock	rowblocks;		// Row blocks decoded by xls_parseWorkSheetRows
 }
 xlsWorkSheet;
 
@@ -62,6 +62,10 @@ void xls_set_formula_hander(xls_formula_handler handler);
 
 xls_error_t xls_parseWorkBook(xlsWorkBook* pWB);
 xls_error_t xls_parseWorkSheet(xlsWorkSheet* pWS);
+// Row-range API: read the sheet index and decode only the row blocks that
+// are needed, falling back to xls_parseWorkSheet if there is no index
+xls_error_t xls_parseWorkSheetIndex(xlsWorkSheet* pWS);
+xls_error_t xls_parseWorkSheetRows(xlsWorkSheet* pWS, WORD firstRow, WORD lastRow);
 
 // Preferred API
 // charset - convert 16bit strings within the spread sheet to this 8-bit encoding (UTF-8 default)
@@ -83,6 +87,8 @@ void xls_close_summaryInfo(xlsSummaryInfo *pSI);
 // utility function
 xlsRow *xls_row(xlsWorkSheet* pWS, WORD cellRow);
 xlsCell	*xls_cell(xlsWorkSheet* pWS, WORD cellRow, WORD cellCol);
+const char *xls_cell_get_str(xlsWorkBook* pWB, xlsCell *cell);
+const char *xls_sst_get_str(xlsWorkBook* pWB, DWORD index);
 
 #ifdef __cplusplus
 } // extern c block
@@ -68,9 +68,12 @@ static xls_formula_handler formula_handler;
 
 static xls_error_t xls_addSST(xlsWorkBook* pWB, SST* sst, DWORD size);
 static xls_error_t xls_appendSST(xlsWorkBook* pWB, BYTE* buf, DWORD size);
+static xls_error_t xls_appendSSTRaw(xlsWorkBook* pWB, struct str_sst_string* str, BYTE* buf, DWORD ln, BYTE is16);
 static xls_error_t xls_addFormat(xlsWorkBook* pWB, FORMAT* format, DWORD size);
 static xls_error_t xls_addSheet(xlsWorkBook* pWB, BOUNDSHEET* bs, DWORD size);
 static xls_error_t xls_addRow(xlsWorkSheet* pWS,ROW* row);
+static xls_error_t xls_makeRows(xlsWorkSheet* pWS);
+static xls_error_t xls_makeRowCells(xlsWorkSheet* pWS, DWORD t);
 static xls_error_t xls_makeTable(xlsWorkSheet* pWS);
 static struct st_cell_data *xls_addCell(xlsWorkSheet* pWS, BOF* bof, BYTE* buf);
 static char *xls_addFont(xlsWorkBook* pWB, FONT* font, DWORD size);
@@ -79,7 +82,10 @@ static xls_error_t xls_addXF5(xlsWorkBook* pWB, XF5* xf);
 static xls_error_t xls_addColinfo(xlsWorkSheet* pWS, COLINFO* colinfo);
 static xls_error_t xls_mergedCells(xlsWorkSheet* pWS, BOF* bof, BYTE* buf);
 static xls_error_t xls_preparseWorkSheet(xlsWorkSheet* pWS);
+static void xls_formatRow(xlsWorkSheet* pWS, DWORD t);
 static xls_error_t xls_formatColumn(xlsWorkSheet* pWS);
+static xls_error_t xls_parseRowBlock(xlsWorkSheet* pWS, DWORD k);
+static xls_error_t xls_getRowBlockFirstRow(xlsWorkSheet* pWS, DWORD k, DWORD *firstrow);
 static void xls_dumpSummary(char *buf, int isSummary, xlsSummaryInfo *pSI);
 
 #if defined(_AIX) || defined(__sun)
@@ -149,6 +155,89 @@ static xls_error_t xls_addSST(xlsWorkBook* pWB,SST* sst,DWORD size)
     return xls_appendSST(pWB, sst->strings, size - offsetof(SST, strings));
 }
 
+// Append characters to the raw SST buffer. Strings are only decoded on
+// first access by xls_sst_get_str.
+static xls_error_t xls_appendSSTRaw(xlsWorkBook* pWB, struct str_sst_string* str, BYTE* buf, DWORD ln, BYTE is16)
+{
+    st_sst *sst = &pWB->sst;
+    DWORD need;
+    DWORD i;
+
+    if (str->len == 0) {
+        str->is16 = is16;
+    }
+    // A continued string may switch from compressed to UTF-16LE characters.
+    // Being the last string, its compressed part is expanded in place.
+    need = (str->is16 || is16) ? 2*ln : ln;
+    if (is16 && !str->is16) {
+        need += str->len;
+    }
+    if (sst->rawsize + need < sst->rawsize)
+        return LIBXLS_ERROR_MALLOC;
+    if (sst->rawsize + need > sst->rawcap) {
+        DWORD cap = sst->rawcap ? sst->rawcap : 4096;
+        BYTE *raw;
+        while (cap < sst->rawsize + need) {
+            if (cap > 0x7FFFFFFF)
+                return LIBXLS_ERROR_MALLOC;
+            cap *= 2;
+        }
+        if ((raw = realloc(sst->raw, cap)) == NULL)
+            return LIBXLS_ERROR_MALLOC;
+        sst->raw = raw;
+        sst->rawcap = cap;
+    }
+    if (is16 && !str->is16) {
+        BYTE *p = sst->raw + str->ofs;
+        for (i = str->len; i > 0; i--) {
+            p[2*i-1] = 0;
+            p[2*i-2] = p[i-1];
+        }
+        sst->rawsize += str->len;
+        str->is16 = 1;
+    }
+    if (str->is16 && !is16) {
+        BYTE *p = sst->raw + sst->rawsize;
+        for (i = 0; i < ln; i++) {
+            p[2*i] = buf[i];
+            p[2*i+1] = 0;
+        }
+        sst->rawsize += 2*ln;
+    } else {
+        memcpy(sst->raw + sst->rawsize, buf, is16 ? 2*ln : ln);
+        sst->rawsize += is16 ? 2*ln : ln;
+    }
+    str->len += ln;
+    return LIBXLS_OK;
+}
+
+const char *xls_sst_get_str(xlsWorkBook* pWB, DWORD index)
+{
+    struct str_sst_string *str;
+
+    if (index >= pWB->sst.lastid)
+        return NULL;
+
+    str = &pWB->sst.string[index];
+    if (str->str == NULL) {
+        const char *raw = (const char *)pWB->sst.raw + str->ofs;
+        if (str->len == 0) {
+            str->str = strdup("");
+        } else if (str->is16) {
+            str->str = unicode_decode(raw, 2*str->len, pWB);
+            if (str->str == NULL) {
+                str->str = strdup("*failed to decode utf16*");
+            }
+        } else {
+            str->str = codepage_decode(raw, str->len, pWB);
+            if (str->str == NULL) {
+                str->str = strdup("*failed to decode BIFF5 string*");
+            }
+        }
+    }
+    return str->str;
+}
+
 static xls_error_t xls_appendSST(xlsWorkBook* pWB, BYTE* buf, DWORD size)
 {
     DWORD ln;	// String character count
@@ -156,7 +245,6 @@ static xls_error_t xls_appendSST(xlsWorkBook* pWB, BYTE* buf, DWORD size)
     DWORD rt;	// Count of rich text formatting runs
     DWORD sz;	// Size of asian phonetic settings block
     BYTE flag;	// String flags
-    char* ret = NULL;
 
     if (xls_debug) {
 	    printf("xls_appendSST %u\n", size);
@@ -167,7 +255,7 @@ static xls_error_t xls_appendSST(xlsWorkBook* pWB, BYTE* buf, DWORD size)
 
 	while(ofs<size)
     {
-        int ln_toread;
+        DWORD ln_toread;
 
         // Restore state when we're in a continue record
         // or read string length
@@ -223,75 +311,38 @@ static xls_error_t xls_appendSST(xlsWorkBook* pWB, BYTE* buf, DWORD size)
             flag = 0;
         }
 
-		// Read characters (compressed or not)
-        ln_toread = 0;
+        // Add string in table, or continue the last string
+        if (!pWB->sst.continued) {
+            if (pWB->sst.lastid >= pWB->sst.count) {
+                return LIBXLS_ERROR_PARSE;
+            }
+            pWB->sst.lastid++;
+            pWB->sst.string[pWB->sst.lastid-1].ofs = pWB->sst.rawsize;
+        } else if (pWB->sst.lastid == 0) {
+            return LIBXLS_ERROR_PARSE;
+        }
+
+		// Store characters (compressed or not)
         if (ln > 0) {
+            xls_error_t retval;
             if (flag & 0x1) {
-                size_t new_len = 0;
                 ln_toread = min((size-ofs)/2, ln);
-                ret=unicode_decode((char *)buf+ofs, ln_toread*2, pWB);
-
-                if (ret == NULL) {
-                    ret = strdup("*failed to decode utf16*");
-                }
-
-                ln -= ln_toread;
+                retval = xls_appendSSTRaw(pWB, &pWB->sst.string[pWB->sst.lastid-1], buf+ofs, ln_toread, 1);
                 ofs+=ln_toread*2;
-
-                if (xls_debug) {
-                    new_len = strlen(ret);
-	                printf("String16SST: %s(%lu)\n", ret, (unsigned long)new_len);
-                }
             } else {
                 ln_toread = min((size-ofs), ln);
-
-                ret = codepage_decode((char *)buf+ofs, ln_toread, pWB);
-                if (ret == NULL) {
-                    ret = strdup("*failed to decode BIFF5 string*");
-                }
-
-                ln  -= ln_toread;
+                retval = xls_appendSSTRaw(pWB, &pWB->sst.string[pWB->sst.lastid-1], buf+ofs, ln_toread, 0);
                 ofs += ln_toread;
-
-                if (xls_debug) {
-                	printf("String8SST: %s(%u) \n",ret,ln);
-                }
             }
-        } else {
-            ret = strdup("");
-        }
-
-        if (ln_toread > 0 || !pWB->sst.continued) {
-            // Concat string if it's a continue, or add string in table
-            if (!pWB->sst.continued) {
-                if (pWB->sst.lastid >= pWB->sst.count) {
-                    free(ret);
-                    return LIBXLS_ERROR_PARSE;
-                }
-                pWB->sst.lastid++;
-                pWB->sst.string[pWB->sst.lastid-1].str=ret;
-            } else {
-                char *tmp = pWB->sst.string[pWB->sst.lastid-1].str;
-                if (tmp == NULL) {
-                    free(ret);
-                    return LIBXLS_ERROR_PARSE;
-                }
-                tmp = realloc(tmp, strlen(tmp)+strlen(ret)+1);
-                if (tmp == NULL)  {
-                    free(ret);
-                    return LIBXLS_ERROR_MALLOC;
-                }
-                pWB->sst.string[pWB->sst.lastid-1].str=tmp;
-                memcpy(tmp+strlen(tmp), ret, strlen(ret)+1);
-				free(ret);
+            if (retval != LIBXLS_OK) {
+                return retval;
             }
+            ln -= ln_toread;
 
-			if (xls_debug) {
-	            printf("String %4u: %s<end>\n", pWB->sst.lastid-1, pWB->sst.string[pWB->sst.lastid-1].str);
-			}
-        } else {
-            free(ret);
-	}
+            if (xls_debug) {
+                printf("String %4u: %u characters\n", pWB->sst.lastid-1, ln_toread);
+            }
+        }
 
 		// Jump list of rich text formatting runs
         if (ofs < size && rt > 0) {
@@ -429,34 +480,57 @@ static xls_error_t xls_addRow(xlsWorkSheet* pWS,ROW* row)
     return LIBXLS_OK;
 }
 
-static xls_error_t xls_makeTable(xlsWorkSheet* pWS)
+static xls_error_t xls_makeRows(xlsWorkSheet* pWS)
 {
-    DWORD i,t;
+    DWORD t;
     struct st_row_data* tmp;
-    verbose ("xls_makeTable");
 
     if ((pWS->rows.row = calloc((pWS->rows.lastrow+1),sizeof(struct st_row_data))) == NULL)
         return LIBXLS_ERROR_MALLOC;
 
-	// printf("ALLOC: rows=%d cols=%d\n", pWS->rows.lastrow, pWS->rows.lastcol);
     for (t=0;t<=pWS->rows.lastrow;t++)
     {
         tmp=&pWS->rows.row[t];
         tmp->index=t;
         tmp->fcell=0;
         tmp->lcell=pWS->rows.lastcol;
+    }
+    return LIBXLS_OK;
+}
 
-		tmp->cells.count = pWS->rows.lastcol+1;
-        if ((tmp->cells.cell = calloc(tmp->cells.count, sizeof(struct st_cell_data))) == NULL)
-            return LIBXLS_ERROR_MALLOC;
+static xls_error_t xls_makeRowCells(xlsWorkSheet* pWS, DWORD t)
+{
+    DWORD i;
+    struct st_row_data* tmp=&pWS->rows.row[t];
 
-        for (i=0;i<=pWS->rows.lastcol;i++)
-        {
-            tmp->cells.cell[i].col = i;
-            tmp->cells.cell[i].row = t;
-            tmp->cells.cell[i].width = pWS->defcolwidth;
-            tmp->cells.cell[i].id = XLS_RECORD_BLANK;
-        }
+    tmp->cells.count = pWS->rows.lastcol+1;
+    if ((tmp->cells.cell = calloc(tmp->cells.count, sizeof(struct st_cell_data))) == NULL)
+        return LIBXLS_ERROR_MALLOC;
+
+    for (i=0;i<=pWS->rows.lastcol;i++)
+    {
+        tmp->cells.cell[i].col = i;
+        tmp->cells.cell[i].row = t;
+        tmp->cells.cell[i].width = pWS->defcolwidth;
+        tmp->cells.cell[i].id = XLS_RECORD_BLANK;
+    }
+    return LIBXLS_OK;
+}
+
+static xls_error_t xls_makeTable(xlsWorkSheet* pWS)
+{
+    DWORD t;
+    xls_error_t retval;
+    verbose ("xls_makeTable");
+
+    if ((retval = xls_makeRows(pWS)) != LIBXLS_OK)
+        return retval;
+
+	// printf("ALLOC: rows=%d cols=%d\n", pWS->rows.lastrow, pWS->rows.lastcol);
+    for (t=0;t<=pWS->rows.lastrow;t++)
+    {
+        if ((retval = xls_makeRowCells(pWS, t)) != LIBXLS_OK)
+            return retval;
     }
     return LIBXLS_OK;
 }
@@ -514,6 +588,39 @@ void xls_cell_set_str(struct st_cell_data *cell, char *str) {
         free(cell->str);
     }
     cell->str = str;
+    if (cell->raw) {
+        free(cell->raw);
+        cell->raw = NULL;
+    }
+}
+
+// Keep a copy of the raw string of a label or formula result, which is
+// decoded by xls_cell_get_str on first access
+static xls_error_t xls_cell_set_raw(struct st_cell_data *cell, const BYTE *raw, DWORD size) {
+    BYTE *tmp = NULL;
+    if (size > 0) {
+        if ((tmp = malloc(size)) == NULL)
+            return LIBXLS_ERROR_MALLOC;
+        memcpy(tmp, raw, size);
+    }
+    xls_cell_set_str(cell, NULL);
+    cell->raw = tmp;
+    cell->rawsize = size;
+    return LIBXLS_OK;
+}
+
+const char *xls_cell_get_str(xlsWorkBook* pWB, struct st_cell_data *cell) {
+    if (cell->id == XLS_RECORD_LABELSST) {
+        return xls_sst_get_str(pWB, cell->sst);
+    }
+    if (cell->str == NULL && cell->raw != NULL) {
+        // LABEL and RSTRING always have a two byte length
+        BYTE is2 = (cell->id == XLS_RECORD_LABEL || cell->id == XLS_RECORD_RSTRING) ? 1 : (BYTE)!pWB->is5ver;
+        cell->str = get_string((char *)cell->raw, cell->rawsize, is2, pWB);
+        free(cell->raw);
+        cell->raw = NULL;
+    }
+    return cell->str;
 }
 
 static struct st_cell_data *xls_addCell(xlsWorkSheet* pWS,BOF* bof,BYTE* buf)
@@ -529,6 +636,10 @@ static struct st_cell_data *xls_addCell(xlsWorkSheet* pWS,BOF* bof,BYTE* buf)
         return NULL;
 
 	// printf("ROW: %u COL: %u\n", xlsShortVal(((COL*)buf)->row), xlsShortVal(((COL*)buf)->col));
+    if (xlsShortVal(((COL*)buf)->row) > pWS->rows.lastrow) {
+        if (xls_debug) fprintf(stderr, "Error: Row index out of bounds\n");
+        return NULL;
+    }
     row=&pWS->rows.row[xlsShortVal(((COL*)buf)->row)];
 
     col = xlsShortVal(((COL*)buf)->col);
@@ -605,13 +716,18 @@ static struct st_cell_data *xls_addCell(xlsWorkSheet* pWS,BOF* bof,BYTE* buf)
         }
         break;
     case XLS_RECORD_LABELSST:
+        // Shared string is decoded on first access by xls_cell_get_str
+        cell->sst = ((LABEL*)buf)->value[0] + (((LABEL*)buf)->value[1] << 8);
+        if(!pWS->workbook->is5ver) {
+            cell->sst += ((DWORD)((LABEL*)buf)->value[2] << 16);
+            cell->sst += ((DWORD)((LABEL*)buf)->value[3] << 24);
+        }
+        xls_cell_set_str(cell, NULL);
+		break;
     case XLS_RECORD_LABEL:
     case XLS_RECORD_RSTRING:
-        xls_cell_set_str(cell, xls_getfcell(pWS->workbook, cell, ((LABEL*)buf)->value));
-        if (cell->str) {
-            sscanf((char *)cell->str, "%d", &cell->l);
-            sscanf((char *)cell->str, "%lf", &cell->d);
-        }
+        if (xls_cell_set_raw(cell, ((LABEL*)buf)->value, bof->size - offsetof(LABEL, value)) != LIBXLS_OK)
+            return NULL;
 		break;
     case XLS_RECORD_RK:
         cell->d=NumFromRk(xlsIntVal(((RK*)buf)->value));
@@ -1225,9 +1341,9 @@ cleanup:
     return retval;
 }
 
-static xls_error_t xls_formatColumn(xlsWorkSheet* pWS)
+static void xls_formatRow(xlsWorkSheet* pWS, DWORD t)
 {
-    DWORD i,t,ii;
+    DWORD i,ii;
     DWORD fcol,lcol;
     WORD width;
     BYTE isHidden;
@@ -1246,13 +1362,20 @@ static xls_error_t xls_formatColumn(xlsWorkSheet* pWS)
         else
             lcol=pWS->rows.lastcol;
 
-        for (ii=0;ii<=pWS->rows.lastrow;ii++) {
-            for (t=fcol;t<=lcol;t++) {
-                pWS->rows.row[ii].cells.cell[t].isHidden |= isHidden;
-                pWS->rows.row[ii].cells.cell[t].width = width;
-            }
+        for (ii=fcol;ii<=lcol;ii++) {
+            pWS->rows.row[t].cells.cell[ii].isHidden |= isHidden;
+            pWS->rows.row[t].cells.cell[ii].width = width;
         }
     }
+}
+
+static xls_error_t xls_formatColumn(xlsWorkSheet* pWS)
+{
+    DWORD t;
+
+    for (t=0;t<=pWS->rows.lastrow;t++)
+        xls_formatRow(pWS, t);
+
     return LIBXLS_OK;
 }
 
@@ -1401,8 +1524,9 @@ xls_error_t xls_parseWorkSheet(xlsWorkSheet* pWS)
 
 		case XLS_RECORD_STRING:
 			if(cell && (cell->id == XLS_RECORD_FORMULA || cell->id == XLS_RECORD_FORMULA_ALT)) {
-                xls_cell_set_str(cell, get_string((char *)buf, tmp.size,
-                            (BYTE)!pWB->is5ver, pWB));
+                if ((retval = xls_cell_set_raw(cell, buf, tmp.size)) != LIBXLS_OK) {
+                    goto cleanup;
+                }
 				if (xls_debug) xls_showCell(cell);
 			}
 			break;
@@ -1430,6 +1554,345 @@ cleanup:
     return retval;
 }
 
+// Read the next record of the workbook stream into a (reallocated) buffer
+static xls_error_t xls_readRecord(OLE2Stream* olestr, BOF* bof, BYTE** buf)
+{
+    if (ole2_read(bof, 1, 4, olestr) != 4) {
+        if (xls_debug) fprintf(stderr, "Error: failed to read OLE size\n");
+        return LIBXLS_ERROR_READ;
+    }
+    xlsConvertBof(bof);
+    if (bof->size) {
+        BYTE* tmp;
+        if ((tmp = realloc(*buf, bof->size)) == NULL) {
+            if (xls_debug) fprintf(stderr, "Error: failed to allocate buffer of size %d\n", (int)bof->size);
+            return LIBXLS_ERROR_MALLOC;
+        }
+        *buf = tmp;
+        if (ole2_read(*buf, 1, bof->size, olestr) != bof->size) {
+            if (xls_debug) fprintf(stderr, "Error: failed to read OLE block\n");
+            return LIBXLS_ERROR_READ;
+        }
+    }
+    return LIBXLS_OK;
+}
+
+xls_error_t xls_parseWorkSheetIndex(xlsWorkSheet* pWS)
+{
+    BOF tmp;
+    BYTE* buf = NULL;
+    xls_error_t retval = LIBXLS_OK;
+    int hasIndex = 0;
+    int hasDimension = 0;
+
+    if(!pWS) return LIBXLS_ERROR_NULL_ARGUMENT;
+
+    verbose ("xls_parseWorkSheetIndex");
+
+    if (pWS->rows.row)
+        return LIBXLS_OK;
+
+    if (ole2_seek(pWS->workbook->olestr,pWS->filepos) == -1) {
+        retval = LIBXLS_ERROR_SEEK;
+        goto cleanup;
+    }
+    // INDEX, DEFCOLWIDTH, COLINFO and DIMENSION precede the cell table
+    do
+    {
+        if ((retval = xls_readRecord(pWS->workbook->olestr, &tmp, &buf)) != LIBXLS_OK) {
+            goto cleanup;
+        }
+        switch (tmp.id)
+        {
+        case XLS_RECORD_INDEX:
+        {
+            DWORD ofs = pWS->workbook->is5ver ? 12 : 16;
+            DWORD i;
+            if (tmp.size < ofs) {
+                retval = LIBXLS_ERROR_PARSE;
+                goto cleanup;
+            }
+            free(pWS->rowblocks.block);
+            pWS->rowblocks.block = NULL;
+            pWS->rowblocks.count = (tmp.size - ofs)/4;
+            if (pWS->rowblocks.count > 0) {
+                if ((pWS->rowblocks.block = calloc(pWS->rowblocks.count, sizeof(struct st_rowblock_data))) == NULL) {
+                    pWS->rowblocks.count = 0;
+                    retval = LIBXLS_ERROR_MALLOC;
+                    goto cleanup;
+                }
+            }
+            for (i=0; i<pWS->rowblocks.count; i++, ofs+=4) {
+                pWS->rowblocks.block[i].dbcell = buf[ofs+0] + (buf[ofs+1] << 8) + (buf[ofs+2] << 16) + ((DWORD)buf[ofs+3] << 24);
+                pWS->rowblocks.block[i].firstrow = 0xFFFFFFFF;
+            }
+            hasIndex = 1;
+            break;
+        }
+        case XLS_RECORD_DIMENSION:
+        {
+            DWORD rl, cl;
+            if (pWS->workbook->is5ver) {
+                if (tmp.size < 4 * sizeof(WORD)) {
+                    retval = LIBXLS_ERROR_PARSE;
+                    goto cleanup;
+                }
+                rl = buf[2] + (buf[3] << 8);
+                cl = buf[6] + (buf[7] << 8);
+            } else {
+                if (tmp.size < 2 * sizeof(DWORD) + 2 * sizeof(WORD)) {
+                    retval = LIBXLS_ERROR_PARSE;
+                    goto cleanup;
+                }
+                rl = buf[4] + (buf[5] << 8) + (buf[6] << 16) + ((DWORD)buf[7] << 24);
+                cl = buf[10] + (buf[11] << 8);
+            }
+            // Both are the index of the last used row/column + 1
+            pWS->rows.lastrow = rl > 0 ? (rl - 1 > 0xFFFF ? 0xFFFF : (WORD)(rl - 1)) : 0;
+            pWS->rows.lastcol = cl > 0 ? (WORD)(cl - 1) : 0;
+            hasDimension = 1;
+            break;
+        }
+        case XLS_RECORD_DEFCOLWIDTH:
+            if (tmp.size < sizeof(WORD)) {
+                retval = LIBXLS_ERROR_PARSE;
+                goto cleanup;
+            }
+            pWS->defcolwidth = (buf[0] << 8) + (buf[1] << 16);
+            break;
+        case XLS_RECORD_COLINFO:
+            if (tmp.size < sizeof(COLINFO)) {
+                retval = LIBXLS_ERROR_PARSE;
+                goto cleanup;
+            }
+            xlsConvertColinfo((COLINFO*)buf);
+            if ((retval = xls_addColinfo(pWS,(COLINFO*)buf)) != LIBXLS_OK)
+                goto cleanup;
+            break;
+        }
+    }
+    while ((!pWS->workbook->olestr->eof) && !hasDimension && tmp.id != XLS_RECORD_EOF &&
+           tmp.id != XLS_RECORD_ROW && tmp.id != XLS_RECORD_DBCELL);
+
+    if (pWS->rows.lastcol > 255) {
+        retval = LIBXLS_ERROR_PARSE;
+        goto cleanup;
+    }
+
+    if (!hasIndex || !hasDimension || pWS->rowblocks.count == 0) {
+        // No usable index: parse the complete sheet
+        free(pWS->rowblocks.block);
+        pWS->rowblocks.block = NULL;
+        pWS->rowblocks.count = 0;
+        free(pWS->colinfo.col);
+        pWS->colinfo.col = NULL;
+        pWS->colinfo.count = 0;
+        pWS->rows.lastrow = 0;
+        pWS->rows.lastcol = 0;
+        retval = xls_parseWorkSheet(pWS);
+        goto cleanup;
+    }
+
+    retval = xls_makeRows(pWS);
+
+cleanup:
+    if (buf)
+        free(buf);
+
+    return retval;
+}
+
+// Get the stream position of the first record of a row block from its DBCELL
+static xls_error_t xls_getRowBlockStart(xlsWorkSheet* pWS, DWORD k, BYTE** buf, DWORD *start)
+{
+    BOF tmp;
+    DWORD ofs;
+    xls_error_t retval;
+    DWORD dbcell = pWS->rowblocks.block[k].dbcell;
+
+    if (ole2_seek(pWS->workbook->olestr, dbcell) == -1)
+        return LIBXLS_ERROR_SEEK;
+    if ((retval = xls_readRecord(pWS->workbook->olestr, &tmp, buf)) != LIBXLS_OK)
+        return retval;
+    if (tmp.id != XLS_RECORD_DBCELL || tmp.size < sizeof(DWORD))
+        return LIBXLS_ERROR_PARSE;
+    // Offset to the first ROW record, counted back from the DBCELL record
+    ofs = (*buf)[0] + ((*buf)[1] << 8) + ((*buf)[2] << 16) + ((DWORD)(*buf)[3] << 24);
+    if (ofs > dbcell - pWS->filepos)
+        return LIBXLS_ERROR_PARSE;
+    *start = dbcell - ofs;
+    return LIBXLS_OK;
+}
+
+static xls_error_t xls_getRowBlockFirstRow(xlsWorkSheet* pWS, DWORD k, DWORD *firstrow)
+{
+    struct st_rowblock_data *block = &pWS->rowblocks.block[k];
+
+    if (block->firstrow == 0xFFFFFFFF) {
+        BOF tmp;
+        BYTE* buf = NULL;
+        DWORD start;
+        xls_error_t retval;
+
+        if ((retval = xls_getRowBlockStart(pWS, k, &buf, &start)) == LIBXLS_OK) {
+            if (ole2_seek(pWS->workbook->olestr, start) == -1) {
+                retval = LIBXLS_ERROR_SEEK;
+            } else if ((retval = xls_readRecord(pWS->workbook->olestr, &tmp, &buf)) == LIBXLS_OK) {
+                // Usually a ROW record, but cells work as well
+                if (tmp.size >= sizeof(COL)) {
+                    block->firstrow = xlsShortVal(((COL*)buf)->row);
+                } else {
+                    retval = LIBXLS_ERROR_PARSE;
+                }
+            }
+        }
+        free(buf);
+        if (retval != LIBXLS_OK)
+            return retval;
+    }
+    *firstrow = block->firstrow;
+    return LIBXLS_OK;
+}
+
+// Ensure that the cells of a row are allocated and formatted
+static xls_error_t xls_prepareRow(xlsWorkSheet* pWS, DWORD t)
+{
+    xls_error_t retval = LIBXLS_OK;
+
+    if (t > pWS->rows.lastrow)
+        return LIBXLS_ERROR_PARSE;
+    if (pWS->rows.row[t].cells.cell == NULL) {
+        if ((retval = xls_makeRowCells(pWS, t)) == LIBXLS_OK)
+            xls_formatRow(pWS, t);
+    }
+    return retval;
+}
+
+static xls_error_t xls_parseRowBlock(xlsWorkSheet* pWS, DWORD k)
+{
+    BOF tmp;
+    BYTE* buf = NULL;
+    DWORD offset;
+    DWORD dbcell = pWS->rowblocks.block[k].dbcell;
+    xls_error_t retval;
+    struct st_cell_data *cell = NULL;
+    xlsWorkBook *pWB = pWS->workbook;
+
+    verbose ("xls_parseRowBlock");
+
+    if ((retval = xls_getRowBlockStart(pWS, k, &buf, &offset)) != LIBXLS_OK)
+        goto cleanup;
+    if (ole2_seek(pWB->olestr, offset) == -1) {
+        retval = LIBXLS_ERROR_SEEK;
+        goto cleanup;
+    }
+    // The ROW and cell records of the row block end at the DBCELL record
+    while (offset < dbcell)
+    {
+        if ((retval = xls_readRecord(pWB->olestr, &tmp, &buf)) != LIBXLS_OK)
+            goto cleanup;
+        offset += 4 + tmp.size;
+
+        switch (tmp.id)
+        {
+        case XLS_RECORD_ROW:
+            if (tmp.size < sizeof(ROW)) {
+                retval = LIBXLS_ERROR_PARSE;
+                goto cleanup;
+            }
+            xlsConvertRow((ROW *)buf);
+            if ((retval = xls_prepareRow(pWS, ((ROW*)buf)->index)) != LIBXLS_OK)
+                goto cleanup;
+            if ((retval = xls_addRow(pWS,(ROW*)buf)) != LIBXLS_OK)
+                goto cleanup;
+            break;
+        case XLS_RECORD_MULRK:
+        case XLS_RECORD_MULBLANK:
+        case XLS_RECORD_NUMBER:
+        case XLS_RECORD_BOOLERR:
+        case XLS_RECORD_RK:
+        case XLS_RECORD_LABELSST:
+        case XLS_RECORD_BLANK:
+        case XLS_RECORD_LABEL:
+        case XLS_RECORD_RSTRING:
+        case XLS_RECORD_FORMULA:
+        case XLS_RECORD_FORMULA_ALT:
+            if (xls_isCellTooSmall(pWB, &tmp, buf)) {
+                retval = LIBXLS_ERROR_PARSE;
+                goto cleanup;
+            }
+            if ((retval = xls_prepareRow(pWS, xlsShortVal(((COL*)buf)->row))) != LIBXLS_OK)
+                goto cleanup;
+            if ((cell = xls_addCell(pWS, &tmp, buf)) == NULL) {
+                retval = LIBXLS_ERROR_PARSE;
+                goto cleanup;
+            }
+            break;
+        case XLS_RECORD_ARRAY:
+            if(formula_handler) formula_handler(tmp.id, tmp.size, buf);
+            break;
+        case XLS_RECORD_STRING:
+            if(cell && (cell->id == XLS_RECORD_FORMULA || cell->id == XLS_RECORD_FORMULA_ALT)) {
+                if ((retval = xls_cell_set_raw(cell, buf, tmp.size)) != LIBXLS_OK)
+                    goto cleanup;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    pWS->rowblocks.block[k].isParsed = 1;
+
+cleanup:
+    if (buf)
+        free(buf);
+
+    return retval;
+}
+
+xls_error_t xls_parseWorkSheetRows(xlsWorkSheet* pWS, WORD firstRow, WORD lastRow)
+{
+    DWORD lo, hi, k, first;
+    xls_error_t retval;
+
+    if(!pWS) return LIBXLS_ERROR_NULL_ARGUMENT;
+
+    if (pWS->rows.row == NULL && (retval = xls_parseWorkSheetIndex(pWS)) != LIBXLS_OK)
+        return retval;
+
+    if (pWS->rowblocks.count == 0) // Completely parsed
+        return LIBXLS_OK;
+
+    if (lastRow > pWS->rows.lastrow)
+        lastRow = pWS->rows.lastrow;
+    if (firstRow > lastRow)
+        return LIBXLS_OK;
+
+    // Binary search for the last row block starting at or before firstRow
+    lo = 0;
+    hi = pWS->rowblocks.count;
+    while (hi - lo > 1) {
+        DWORD mid = lo + (hi - lo)/2;
+        if ((retval = xls_getRowBlockFirstRow(pWS, mid, &first)) != LIBXLS_OK)
+            return retval;
+        if (first <= firstRow)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    for (k = lo; k < pWS->rowblocks.count; k++) {
+        if ((retval = xls_getRowBlockFirstRow(pWS, k, &first)) != LIBXLS_OK)
+            return retval;
+        if (first > lastRow)
+            break;
+        if (!pWS->rowblocks.block[k].isParsed &&
+            (retval = xls_parseRowBlock(pWS, k)) != LIBXLS_OK)
+            return retval;
+    }
+    return LIBXLS_OK;
+}
+
 xlsWorkSheet * xls_getWorkSheet(xlsWorkBook* pWB,int num)
 {
     xlsWorkSheet * pWS = NULL;
@@ -1608,6 +2071,7 @@ void xls_close_WB(xlsWorkBook* pWB)
             free(pWB->sst.string[i].str);
         }
         free(pWB->sst.string);
+        free(pWB->sst.raw);
     }
 
     // xfs
@@ -1661,6 +2125,7 @@ void xls_close_WS(xlsWorkSheet* pWS)
             struct st_row_data *row = &pWS->rows.row[j];
             for(i=0; i<row->cells.count; ++i) {
                 free(row->cells.cell[i].str);
+                free(row->cells.cell[i].raw);
             }
             free(row->cells.cell);
         }
@@ -1671,6 +2136,11 @@ void xls_close_WS(xlsWorkSheet* pWS)
     {
         free(pWS->colinfo.col);
     }
+
+    // Row blocks
+    {
+        free(pWS->rowblocks.block);
+    }
     free(pWS);
 }
 
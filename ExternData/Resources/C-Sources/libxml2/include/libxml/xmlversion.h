@@ -87,7 +87,7 @@
  *
  * Whether the push parsing interfaces are configured in
  */
-#if 0
+#if 1
 #define LIBXML_PUSH_ENABLED
 #endif
 
@@ -96,7 +96,7 @@
  *
  * Whether the xmlReader parsing interface is configured in
  */
-#if 0
+#if 1
 #define LIBXML_READER_ENABLED
 #endif
 
@@ -105,7 +105,7 @@
  *
  * Whether the xmlPattern node selection interface is configured in
  */
-#if 0
+#if 1
 #define LIBXML_PATTERN_ENABLED
 #endif
 
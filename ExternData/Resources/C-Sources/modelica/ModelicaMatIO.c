@@ -2102,35 +2102,56 @@ ReadDataSlab1(mat_t *mat, void *data, enum matio_classes class_type, enum matio_
     do {                                                                                  \
         /* If stride[0] is 1 and stride[1] is 1, we are reading all of the */             \
         /* data so get rid of the loops. */                                               \
+        offset = (mat_off_t)start[1] * dims[0] * data_size;                               \
+        if ( CheckSeekFile((FILE *)mat->fp, offset) != MATIO_E_NO_ERROR ||                \
+             fseeko((FILE *)mat->fp, offset, SEEK_CUR) != 0 ) {                           \
+            Mat_Critical("Couldn't set file position");                                   \
+            return -1;                                                                    \
+        }                                                                                 \
         if ( (stride[0] == 1 && (size_t)edge[0] == dims[0]) && (stride[1] == 1) ) {       \
             ReadDataFunc(mat, ptr, data_type, (ptrdiff_t)edge[0] * edge[1]);              \
         } else {                                                                          \
-            row_stride = (long)(stride[0] - 1) * data_size;                               \
-            col_stride = (long)stride[1] * dims[0] * data_size;                           \
-            pos = ftell((FILE *)mat->fp);                                                 \
-            if ( pos == -1L ) {                                                           \
-                Mat_Critical("Couldn't determine file position");                         \
-                return -1;                                                                \
-            }                                                                             \
-            (void)fseek((FILE *)mat->fp, (long)start[1] * dims[0] * data_size, SEEK_CUR); \
+            row_stride = (mat_off_t)(stride[0] - 1) * data_size;                          \
+            col_stride = (mat_off_t)stride[1] * dims[0] * data_size;                      \
             for ( i = 0; i < edge[1]; i++ ) {                                             \
-                pos = ftell((FILE *)mat->fp);                                             \
+                pos = ftello((FILE *)mat->fp);                                            \
                 if ( pos == -1L ) {                                                       \
                     Mat_Critical("Couldn't determine file position");                     \
                     return -1;                                                            \
                 }                                                                         \
-                (void)fseek((FILE *)mat->fp, (long)start[0] * data_size, SEEK_CUR);       \
-                for ( j = 0; j < edge[0]; j++ ) {                                         \
-                    ReadDataFunc(mat, ptr++, data_type, 1);                               \
-                    (void)fseek((FILE *)mat->fp, row_stride, SEEK_CUR);                   \
-                }                                                                         \
-                pos2 = ftell((FILE *)mat->fp);                                            \
-                if ( pos2 == -1L ) {                                                      \
-                    Mat_Critical("Couldn't determine file position");                     \
+                offset = (mat_off_t)start[0] * data_size;                                 \
+                if ( CheckSeekFile((FILE *)mat->fp, offset) != MATIO_E_NO_ERROR ||        \
+                     fseeko((FILE *)mat->fp, offset, SEEK_CUR) != 0 ) {                   \
+                    Mat_Critical("Couldn't set file position");                           \
                     return -1;                                                            \
                 }                                                                         \
-                pos += col_stride - pos2;                                                 \
-                (void)fseek((FILE *)mat->fp, pos, SEEK_CUR);                              \
+                if ( row_stride == 0 ) {                                                  \
+                    /* Contiguous rows of a column are read at once */                    \
+                    ReadDataFunc(mat, ptr, data_type, edge[0]);                           \
+                    ptr += edge[0];                                                       \
+                } else {                                                                  \
+                    for ( j = 0; j < edge[0]; j++ ) {                                     \
+                        if ( j > 0 &&                                                     \
+                             fseeko((FILE *)mat->fp, row_stride, SEEK_CUR) != 0 ) {       \
+                            Mat_Critical("Couldn't set file position");                   \
+                            return -1;                                                    \
+                        }                                                                 \
+                        ReadDataFunc(mat, ptr++, data_type, 1);                           \
+                    }                                                                     \
+                }                                                                         \
+                if ( i + 1 < edge[1] ) {                                                  \
+                    pos2 = ftello((FILE *)mat->fp);                                       \
+                    if ( pos2 == -1L ) {                                                  \
+                        Mat_Critical("Couldn't determine file position");                 \
+                        return -1;                                                        \
+                    }                                                                     \
+                    offset = pos + col_stride - pos2;                                     \
+                    if ( CheckSeekFile((FILE *)mat->fp, offset) != MATIO_E_NO_ERROR ||    \
+                         fseeko((FILE *)mat->fp, offset, SEEK_CUR) != 0 ) {               \
+                        Mat_Critical("Couldn't set file position");                       \
+                        return -1;                                                        \
+                    }                                                                     \
+                }                                                                         \
             }                                                                             \
         }                                                                                 \
     } while ( 0 )
@@ -2154,7 +2175,7 @@ ReadDataSlab2(mat_t *mat, void *data, enum matio_classes class_type, enum matio_
               const size_t *dims, const int *start, const int *stride, const int *edge)
 {
     int nBytes = 0, data_size, i, j;
-    long pos, row_stride, col_stride, pos2;
+    mat_off_t pos, row_stride, col_stride, pos2, offset;
 
     if ( (mat == NULL) || (data == NULL) || (mat->fp == NULL) || (start == NULL) ||
          (stride == NULL) || (edge == NULL) ) {
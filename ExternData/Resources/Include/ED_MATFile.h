@@ -19,8 +19,15 @@ extern "C" {
 void* ED_createMAT(const char* fileName, int verbose);
 void ED_destroyMAT(void* _mat);
 void ED_getDoubleArray2DFromMAT(void* _mat, const char* varName, double* a, size_t m, size_t n);
+void ED_getIntArray2DFromMAT(void* _mat, const char* varName, int* a, size_t m, size_t n);
+void ED_getBooleanArray2DFromMAT(void* _mat, const char* varName, int* a, size_t m, size_t n);
 void ED_getStringArray1DFromMAT(void* _mat, const char* varName, const char** a, size_t m);
 void ED_getArray2DDimensionsFromMAT(void* _mat, const char* varName, int* m, int* n);
+int ED_getSparseNonZerosFromMAT(void* _mat, const char* varName);
+void ED_getSparseDoubleArray2DFromMAT(void* _mat, const char* varName, int* rowPtr, int* colIdx, double* a, size_t m, size_t nnz);
+void ED_getDoubleArray2DFromSparseMAT(void* _mat, const char* varName, double* a, size_t m, size_t n);
+int ED_getTrajectorySizeFromMAT(void* _mat, const char* varName);
+void ED_getTrajectoryFromMAT(void* _mat, const char* varName, double* a, size_t n);
 
 #if defined(__cplusplus)
 }
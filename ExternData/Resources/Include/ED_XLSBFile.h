@@ -0,0 +1,32 @@
+/* ED_XLSBFile.h - Excel XLSB functions header
+ *
+ * Copyright (C) 2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#if !defined(ED_XLSBFILE_H)
+#define ED_XLSBFILE_H
+
+#include <stddef.h>
+#include "msvc_compatibility.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void* ED_createXLSB(const char* fileName, int verbose, int detectMissingData);
+void* ED_createXLSBPreload(const char* fileName, int verbose, int detectMissingData, int preload, const char** sheetNames, size_t nSheetNames);
+void ED_destroyXLSB(void* _xlsb);
+double ED_getDoubleFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, int* exist);
+const char* ED_getStringFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, int* exist);
+int ED_getIntFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, int* exist);
+void ED_getDoubleArray2DFromXLSB(void* _xlsb, const char* cellAddress, const char* sheetName, double* a, size_t m, size_t n);
+void ED_getArray2DDimensionsFromXLSB(void* _xlsb, const char* sheetName, int* m, int* n);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 void* ED_createXLS(const char* fileName, const char* encoding, int verbose, int detectMissingData);
+void* ED_createXLSPreload(const char* fileName, const char* encoding, int verbose, int detectMissingData, int preload, const char** sheetNames, size_t nSheetNames);
 void ED_destroyXLS(void* _xls);
 double ED_getDoubleFromXLS(void* _xls, const char* cellAddress, const char* sheetName, int* exist);
 const char* ED_getStringFromXLS(void* _xls, const char* cellAddress, const char* sheetName, int* exist);
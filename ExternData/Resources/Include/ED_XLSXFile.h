@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 void* ED_createXLSX(const char* fileName, int verbose, int detectMissingData);
+void* ED_createXLSXPreload(const char* fileName, int verbose, int detectMissingData, int preload, const char** sheetNames, size_t nSheetNames);
 void ED_destroyXLSX(void* _xlsx);
 double ED_getDoubleFromXLSX(void* _xlsx, const char* cellAddress, const char* sheetName, int* exist);
 const char* ED_getStringFromXLSX(void* _xlsx, const char* cellAddress, const char* sheetName, int* exist);
@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 void* ED_createXML2(const char* fileName, const char** ns, size_t sizeNS, int verbose, int detectMissingData);
+void* ED_createXML2Streaming(const char* fileName, const char** ns, size_t sizeNS, const char** patterns, size_t sizePatterns, int verbose, int detectMissingData);
 void ED_destroyXML2(void* _xml);
 double ED_getDoubleFromXML2(void* _xml, const char* varName, int* exist);
 const char* ED_getStringFromXML2(void* _xml, const char* varName, int* exist);
@@ -25,6 +26,14 @@ void ED_getDoubleArray1DFromXML2(void* _xml, const char* varName, double* a, siz
 void ED_getDoubleArray2DFromXML2(void* _xml, const char* varName, double* a, size_t m, size_t n);
 void ED_getArray1DDimensionFromXML2(void* _xml, const char* varName, int* n);
 void ED_getArray2DDimensionsFromXML2(void* _xml, const char* varName, int* m, int* n);
+double ED_getDoubleFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist);
+const char* ED_getStringFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist);
+int ED_getIntFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist);
+int ED_getBooleanFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist);
+const char* ED_getUnitFromSSV(void* _xml, const char* varName, const char* nameSpace, int* exist);
+void ED_getDoubleArray1DFromSSV(void* _xml, const char* varName, const char* nameSpace, double* a, size_t n);
+void ED_getDoubleArray2DFromSSV(void* _xml, const char* varName, const char* nameSpace, double* a, size_t m, size_t n);
+int ED_getArrayDimensionFromSSV(void* _xml, const char* varName, const char* nameSpace, int dim, int* exist);
 
 #if defined(__cplusplus)
 }
@@ -51,6 +51,51 @@ TEST_P(MATFiles, GetDoubleArray2D) {
     ED_destroyMAT(handle);
 }
 
+TEST_P(MATFiles, GetIntArray2D) {
+    auto handle = ED_createMAT(GetParam(), verbose_on);
+    ASSERT_NE(nullptr, handle);
+    auto table = std::array<int, 6>{};
+    ED_getIntArray2DFromMAT(handle, "table1", table.data(), 3, 2);
+    EXPECT_EQ(table[0], 0);
+    EXPECT_EQ(table[1], 0);
+    EXPECT_EQ(table[2], 0);
+    EXPECT_EQ(table[3], 0);
+    EXPECT_EQ(table[4], 1);
+    EXPECT_EQ(table[5], 1);
+    ED_destroyMAT(handle);
+}
+
+TEST_P(MATFiles, GetBooleanArray2D) {
+    auto handle = ED_createMAT(GetParam(), verbose_on);
+    ASSERT_NE(nullptr, handle);
+    auto table = std::array<int, 6>{};
+    ED_getBooleanArray2DFromMAT(handle, "table1", table.data(), 3, 2);
+    EXPECT_EQ(table[0], 0);
+    EXPECT_EQ(table[1], 0);
+    EXPECT_EQ(table[2], 1);
+    EXPECT_EQ(table[3], 1);
+    EXPECT_EQ(table[4], 1);
+    EXPECT_EQ(table[5], 1);
+    ED_destroyMAT(handle);
+}
+
+TEST_P(MATFiles, GetDoubleArray2DRepeated) {
+    auto handle = ED_createMAT(GetParam(), verbose_off);
+    ASSERT_NE(nullptr, handle);
+    auto table = std::array<double, 6>{};
+    for (int i = 0; i < 2; ++i) {
+        table.fill(-1);
+        ED_getDoubleArray2DFromMAT(handle, "table1", table.data(), 3, 2);
+        EXPECT_EQ(table[2], 0.5);
+        EXPECT_EQ(table[3], 0.25);
+    }
+    int m, n;
+    ED_getArray2DDimensionsFromMAT(handle, "table1", &m, &n);
+    EXPECT_EQ(m, 3);
+    EXPECT_EQ(n, 2);
+    ED_destroyMAT(handle);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ED_MAT, MATFiles,
     ::testing::Values(
@@ -60,6 +105,153 @@ INSTANTIATE_TEST_SUITE_P(
         "../Examples/test_v7.3.mat")
 );
 
+TEST(ED_MAT, GetStructFields) {
+    // Fields of uncompressed structs are located in the file mapping, fields
+    // of compressed structs are read by matio
+    for (auto fileName : {"../Examples/test_struct_v6.mat", "../Examples/test_struct_v7.mat"}) {
+        auto handle = ED_createMAT(fileName, verbose_on);
+        ASSERT_NE(nullptr, handle);
+        auto table = std::array<double, 6>{};
+        ED_getDoubleArray2DFromMAT(handle, "params.gain.table", table.data(), 3, 2);
+        EXPECT_EQ(table, (std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1}));
+        auto x = std::array<double, 2>{};
+        ED_getDoubleArray2DFromMAT(handle, "params.gain.k", x.data(), 1, 1);
+        EXPECT_EQ(x[0], 2);
+        ED_getDoubleArray2DFromMAT(handle, "params.offset", x.data(), 1, 1);
+        EXPECT_EQ(x[0], 0.1);
+        ED_getDoubleArray2DFromMAT(handle, "params.single", x.data(), 1, 2);
+        EXPECT_EQ(x, (std::array<double, 2>{0.5, 0.25}));
+        ED_getDoubleArray2DFromMAT(handle, "params.gain.k", x.data(), 1, 1);
+        EXPECT_EQ(x[0], 2);
+        ED_getDoubleArray2DFromMAT(handle, "after", x.data(), 1, 1);
+        EXPECT_EQ(x[0], 1);
+        ED_destroyMAT(handle);
+    }
+}
+
+class MATIntFiles
+    : public ::testing::TestWithParam<const char *> {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_P(MATIntFiles, GetIntArray2D) {
+    auto handle = ED_createMAT(GetParam(), verbose_on);
+    ASSERT_NE(nullptr, handle);
+    auto table = std::array<int, 6>{};
+    ED_getIntArray2DFromMAT(handle, "i64", table.data(), 3, 2);
+    EXPECT_EQ(table, (std::array<int, 6>{1, -4, 2, 5, -3, 6}));
+    auto v = std::array<int, 3>{};
+    ED_getIntArray2DFromMAT(handle, "u64", v.data(), 1, 2);
+    EXPECT_EQ(v[0], 7);
+    EXPECT_EQ(v[1], 8);
+    ED_getIntArray2DFromMAT(handle, "i16", v.data(), 3, 1);
+    EXPECT_EQ(v, (std::array<int, 3>{-1, 0, 2}));
+    ED_getBooleanArray2DFromMAT(handle, "i16", v.data(), 3, 1);
+    EXPECT_EQ(v, (std::array<int, 3>{1, 0, 1}));
+    ED_getBooleanArray2DFromMAT(handle, "big", v.data(), 1, 2);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v[1], 1);
+    ED_destroyMAT(handle);
+}
+
+void getIntArray2DOutOfRange(const char* fileName, const char* varName, size_t m, size_t n) {
+    auto handle = ED_createMAT(fileName, verbose_off);
+    auto v = std::array<int, 2>{};
+    ED_getIntArray2DFromMAT(handle, varName, v.data(), m, n);
+    ED_destroyMAT(handle);
+}
+
+TEST_P(MATIntFiles, GetIntArray2DOutOfRange) {
+    // Wide integer classes are not silently narrowed
+    EXPECT_DEATH(getIntArray2DOutOfRange(GetParam(), "big", 1, 2), "Value 4294967296 of element \\(1,2\\)");
+    EXPECT_DEATH(getIntArray2DOutOfRange(GetParam(), "ubig", 2, 1), "Value 3000000000 of element \\(2,1\\)");
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ED_MAT, MATIntFiles,
+    ::testing::Values(
+        "../Examples/test_int_v6.mat",
+        "../Examples/test_int_v7.mat")
+);
+
+TEST(ED_MAT, GetTrajectory) {
+    auto handle = ED_createMAT("../Examples/test_dsres.mat", verbose_on);
+    ASSERT_NE(nullptr, handle);
+    EXPECT_EQ(ED_getTrajectorySizeFromMAT(handle, "time"), 5);
+    EXPECT_EQ(ED_getTrajectorySizeFromMAT(handle, "k"), 2);
+    auto x = std::array<double, 5>{};
+    ED_getTrajectoryFromMAT(handle, "x", x.data(), 5);
+    EXPECT_EQ(x[1], 1);
+    EXPECT_EQ(x[4], 16);
+    ED_getTrajectoryFromMAT(handle, "y", x.data(), 5);
+    EXPECT_EQ(x[1], -1);
+    EXPECT_EQ(x[4], -16);
+    ED_getTrajectoryFromMAT(handle, "time", x.data(), 5);
+    EXPECT_EQ(x[2], 0.5);
+    auto k = std::array<double, 2>{};
+    ED_getTrajectoryFromMAT(handle, "k", k.data(), 2);
+    EXPECT_EQ(k[0], 3.5);
+    EXPECT_EQ(k[1], 3.5);
+    ED_destroyMAT(handle);
+}
+
+TEST(ED_MAT, GetTrajectoryUnmapped) {
+    // Big-endian data is not read from the file mapping: the short columns
+    // of data_1 are read as a whole, the long columns of data_2 strided
+    auto handle = ED_createMAT("../Examples/test_dsres_be.mat", verbose_on);
+    ASSERT_NE(nullptr, handle);
+    auto k = std::array<double, 2>{};
+    ED_getTrajectoryFromMAT(handle, "k", k.data(), 2);
+    EXPECT_EQ(k, (std::array<double, 2>{3.5, 3.5}));
+    auto x = std::array<double, 5>{};
+    ED_getTrajectoryFromMAT(handle, "time", x.data(), 5);
+    EXPECT_EQ(x, (std::array<double, 5>{0, 0.25, 0.5, 0.75, 1}));
+    ED_getTrajectoryFromMAT(handle, "s600", x.data(), 5);
+    EXPECT_EQ(x, (std::array<double, 5>{60000, 60001, 60002, 60003, 60004}));
+    ED_getTrajectoryFromMAT(handle, "m5", x.data(), 5);
+    EXPECT_EQ(x, (std::array<double, 5>{-500, -501, -502, -503, -504}));
+    ED_destroyMAT(handle);
+}
+
+TEST(ED_MAT, GetSparseArray2D) {
+    auto handle = ED_createMAT("../Examples/test_sparse.mat", verbose_on);
+    ASSERT_NE(nullptr, handle);
+    int m = 0;
+    int n = 0;
+    ED_getArray2DDimensionsFromMAT(handle, "sp", &m, &n);
+    EXPECT_EQ(m, 4);
+    EXPECT_EQ(n, 3);
+    EXPECT_EQ(ED_getSparseNonZerosFromMAT(handle, "sp"), 5);
+    auto rowPtr = std::array<int, 5>{};
+    auto colIdx = std::array<int, 5>{};
+    auto values = std::array<double, 5>{};
+    ED_getSparseDoubleArray2DFromMAT(handle, "sp", rowPtr.data(), colIdx.data(), values.data(), 4, 5);
+    EXPECT_EQ(rowPtr, (std::array<int, 5>{1, 3, 4, 5, 6}));
+    EXPECT_EQ(colIdx, (std::array<int, 5>{1, 3, 2, 1, 3}));
+    EXPECT_EQ(values, (std::array<double, 5>{1, 4, 3, 2, 5}));
+    auto a = std::array<double, 12>{};
+    ED_getDoubleArray2DFromSparseMAT(handle, "sp", a.data(), 4, 3);
+    EXPECT_EQ(a, (std::array<double, 12>{1, 0, 4, 0, 3, 0, 2, 0, 0, 0, 0, 5}));
+    ED_destroyMAT(handle);
+}
+
+void getInvalidSparseArray2D(const char* varName) {
+    auto handle = ED_createMAT("../Examples/test_sparse_invalid.mat", verbose_off);
+    auto rowPtr = std::array<int, 5>{};
+    auto colIdx = std::array<int, 5>{};
+    auto values = std::array<double, 5>{};
+    ED_getSparseDoubleArray2DFromMAT(handle, varName, rowPtr.data(), colIdx.data(), values.data(), 4, 5);
+    ED_destroyMAT(handle);
+}
+
+TEST(ED_MAT, GetInvalidSparseArray2D) {
+    // "jc" has decreasing column pointers, "ir" has a row index beyond the last row
+    EXPECT_DEATH(getInvalidSparseArray2D("jc"), "Inconsistent sparse data");
+    EXPECT_DEATH(getInvalidSparseArray2D("ir"), "Inconsistent sparse data");
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
@@ -44,6 +44,57 @@ TEST(ED_XLS, GetDoubleArray2D) {
     ED_destroyXLS(handle);
 }
 
+TEST(ED_XLS, GetString) {
+    auto handle = ED_createXLS("../Examples/test.xls", "UTF-8", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist = 0;
+    EXPECT_STREQ(ED_getStringFromXLS(handle, "A1", "set1", &exist), "Parameter");
+    EXPECT_EQ(exist, 1);
+    EXPECT_STREQ(ED_getStringFromXLS(handle, "A2", "set1", &exist), "gain");
+    EXPECT_STREQ(ED_getStringFromXLS(handle, "A3", "set1", &exist), "offset");
+    EXPECT_EQ(ED_getDoubleFromXLS(handle, "B2", "set1", &exist), 2);
+    EXPECT_EQ(exist, 1);
+    // The string decoded on first access is kept after reading other cells
+    EXPECT_STREQ(ED_getStringFromXLS(handle, "A2", "set1", &exist), "gain");
+    EXPECT_EQ(exist, 1);
+    ED_destroyXLS(handle);
+}
+
+TEST(ED_XLS, Preload) {
+    const char* sheetNames[] = {"set1", "table1", "unknown"};
+    auto handle = ED_createXLSPreload("../Examples/test.xls", "UTF-8", verbose_on, log_debug, 1, sheetNames, 3);
+    ASSERT_NE(nullptr, handle);
+    int exist = 0;
+    EXPECT_STREQ(ED_getStringFromXLS(handle, "A2", "set1", &exist), "gain");
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLS(handle, "B2", "set1", &exist), 2);
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray2DFromXLS(handle, "A1", "table1", table.data(), 3, 2);
+    EXPECT_EQ(table[2], 0.5);
+    EXPECT_EQ(table[3], 0.25);
+    ED_destroyXLS(handle);
+}
+
+TEST(ED_XLS, GetAcrossRowBlocks) {
+    auto handle = ED_createXLS("../Examples/test_rows.xls", "UTF-8", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int m, n;
+    ED_getArray2DDimensionsFromXLS(handle, "rows", &m, &n);
+    EXPECT_EQ(m, 200);
+    EXPECT_EQ(n, 2);
+    // Row blocks hold 32 rows each, the last one only 8 rows
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromXLS(handle, "A200", "rows", &exist), 200);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLS(handle, "B33", "rows", &exist), 16.5);
+    EXPECT_EQ(ED_getDoubleFromXLS(handle, "B32", "rows", &exist), 16);
+    EXPECT_EQ(ED_getDoubleFromXLS(handle, "A1", "rows", &exist), 1);
+    auto table = std::array<double, 8>{};
+    ED_getDoubleArray2DFromXLS(handle, "A63", "rows", table.data(), 4, 2);
+    EXPECT_EQ(table, (std::array<double, 8>{63, 31.5, 64, 32, 65, 32.5, 66, 33}));
+    ED_destroyXLS(handle);
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
@@ -0,0 +1,116 @@
+/* Test_ED_XLSB.cc - XLSB functions tester
+ *
+ * Copyright (C) 2015-2026, Thomas Beutlich
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "../Include/ED_XLSBFile.h"
+#include "Constants.h"
+#include <array>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST(ED_XLSB, Create) {
+    auto handle = ED_createXLSB("../Examples/test.xlsb", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    ED_destroyXLSB(handle);
+}
+
+TEST(ED_XLSB, GetDouble) {
+    auto handle = ED_createXLSB("../Examples/test.xlsb", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist = 0;
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "B2", "set1", &exist), 2);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "B3", "set1", &exist), 0.1);
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "B3", "set2", &exist), 0.1);
+    EXPECT_EQ(ED_getIntFromXLSB(handle, "B2", "set2", &exist), -2);
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "B1", "types", &exist), 1);
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "A70001", "types", &exist), 70001);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "C5", "set1", &exist), 0);
+    EXPECT_EQ(exist, 0);
+    ED_destroyXLSB(handle);
+}
+
+TEST(ED_XLSB, GetString) {
+    auto handle = ED_createXLSB("../Examples/test.xlsb", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist = 0;
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "A1", "", &exist), "Parameter");
+    EXPECT_EQ(exist, 1);
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "A2", "set1", &exist), "gain");
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "B3", "set1", &exist), "0.1");
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "A1", "types", &exist), "inline");
+    EXPECT_EQ(std::string(ED_getStringFromXLSB(handle, "A2", "types", &exist)), std::string(40000, 'x'));
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "C1", "types", &exist), "#DIV/0!");
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "D1", "types", &exist), "abc");
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "D2", "types", &exist), "rich");
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "B70001", "types", &exist), "Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xF0\x9D\x84\x9E");
+    ED_destroyXLSB(handle);
+}
+
+TEST(ED_XLSB, GetArray2DDimensions) {
+    auto handle = ED_createXLSB("../Examples/test.xlsb", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int m, n;
+    ED_getArray2DDimensionsFromXLSB(handle, "table1", &m, &n);
+    EXPECT_EQ(m, 3);
+    EXPECT_EQ(n, 2);
+    ED_destroyXLSB(handle);
+}
+
+TEST(ED_XLSB, GetDoubleArray2D) {
+    auto handle = ED_createXLSB("../Examples/test.xlsb", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray2DFromXLSB(handle, "A1", "table1", table.data(), 3, 2);
+    EXPECT_EQ(table[0], 0);
+    EXPECT_EQ(table[1], 0);
+    EXPECT_EQ(table[2], 0.5);
+    EXPECT_EQ(table[3], 0.25);
+    EXPECT_EQ(table[4], 1);
+    EXPECT_EQ(table[5], 1);
+    ED_destroyXLSB(handle);
+}
+
+TEST(ED_XLSB, Preload) {
+    const char* sheetNames[] = {"set1", "types"};
+    auto handle = ED_createXLSBPreload("../Examples/test.xlsb", verbose_on, log_debug, 1, sheetNames, 2);
+    ASSERT_NE(nullptr, handle);
+    int exist = 0;
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "B2", "set1", &exist), 2);
+    EXPECT_EQ(exist, 1);
+    EXPECT_STREQ(ED_getStringFromXLSB(handle, "D1", "types", &exist), "abc");
+    EXPECT_EQ(ED_getDoubleFromXLSB(handle, "A70001", "types", &exist), 70001);
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray2DFromXLSB(handle, "A1", "table1", table.data(), 3, 2);
+    EXPECT_EQ(table[2], 0.5);
+    EXPECT_EQ(table[3], 0.25);
+    ED_destroyXLSB(handle);
+}
+
+void getIntFromFraction() {
+    auto handle = ED_createXLSB("../Examples/test.xlsb", verbose_off, log_debug);
+    int exist = 0;
+    ED_getIntFromXLSB(handle, "B3", "set1", &exist);
+    ED_destroyXLSB(handle);
+}
+
+TEST(ED_XLSB, GetIntFromFraction) {
+    // Numeric cells are converted from the stored double, 0.1 is no int
+    EXPECT_DEATH(getIntFromFraction(), "Cannot read int value 0.10000000000000001");
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -20,6 +20,46 @@ TEST(ED_XLSX, Create) {
     ED_destroyXLSX(handle);
 }
 
+TEST(ED_XLSX, GetDouble) {
+    auto handle = ED_createXLSX("../Examples/test.xlsx", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "B2", "set1", &exist), 2);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "B3", "set2", &exist), 0.1);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getIntFromXLSX(handle, "B2", "set2", &exist), -2);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "C5", "set1", &exist), 0);
+    EXPECT_EQ(exist, 0);
+    ED_destroyXLSX(handle);
+}
+
+TEST(ED_XLSX, GetString) {
+    auto handle = ED_createXLSX("../Examples/test.xlsx", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_STREQ(ED_getStringFromXLSX(handle, "A2", "set1", &exist), "gain");
+    EXPECT_EQ(exist, 1);
+    EXPECT_STREQ(ED_getStringFromXLSX(handle, "B3", "set1", &exist), "0.1");
+    EXPECT_EQ(exist, 1);
+    ED_destroyXLSX(handle);
+}
+
+TEST(ED_XLSX, GetStoredNumberText) {
+    auto handle = ED_createXLSX("../Examples/test_values.xlsx", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_STREQ(ED_getStringFromXLSX(handle, "A1", "values", &exist), "0.10000000000000001");
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "A1", "values", &exist), 0.1);
+    EXPECT_STREQ(ED_getStringFromXLSX(handle, "A2", "values", &exist), "1E-3");
+    EXPECT_STREQ(ED_getStringFromXLSX(handle, "A3", "values", &exist), "2.50");
+    EXPECT_EQ(ED_getIntFromXLSX(handle, "A4", "values", &exist), 3);
+    EXPECT_EQ(exist, 1);
+    ED_destroyXLSX(handle);
+}
+
 TEST(ED_XLS, GetArray2DDimensions) {
     auto handle = ED_createXLSX("../Examples/test.xlsx", verbose_on, log_debug);
     ASSERT_NE(nullptr, handle);
@@ -44,6 +84,73 @@ TEST(ED_XLS, GetDoubleArray2D) {
     ED_destroyXLSX(handle);
 }
 
+TEST(ED_XLS, GetDoubleArray2DOffset) {
+    auto handle = ED_createXLSX("../Examples/test.xlsx", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    auto table = std::array<double, 4>{};
+    ED_getDoubleArray2DFromXLSX(handle, "B2", "table1", table.data(), 2, 2);
+    EXPECT_EQ(table[0], 0.25);
+    EXPECT_EQ(table[1], 0);
+    EXPECT_EQ(table[2], 1);
+    EXPECT_EQ(table[3], 0);
+    ED_destroyXLSX(handle);
+}
+
+TEST(ED_XLSX, GetBeyondRow65535) {
+    auto handle = ED_createXLSX("../Examples/test_rows.xlsx", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int m, n;
+    ED_getArray2DDimensionsFromXLSX(handle, "rows", &m, &n);
+    EXPECT_EQ(m, 70001);
+    EXPECT_EQ(n, 2);
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "A65537", "rows", &exist), 65537);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "B70001", "rows", &exist), 35000.5);
+    EXPECT_EQ(exist, 1);
+    auto table = std::array<double, 8>{};
+    ED_getDoubleArray2DFromXLSX(handle, "A65535", "rows", table.data(), 4, 2);
+    EXPECT_EQ(table[0], 65535);
+    EXPECT_EQ(table[1], 32767.5);
+    EXPECT_EQ(table[2], 65536);
+    EXPECT_EQ(table[3], 32768);
+    EXPECT_EQ(table[4], 65537);
+    EXPECT_EQ(table[5], 32768.5);
+    EXPECT_EQ(table[6], 65538);
+    EXPECT_EQ(table[7], 32769);
+    ED_destroyXLSX(handle);
+}
+
+TEST(ED_XLSX, Preload) {
+    auto handle = ED_createXLSXPreload("../Examples/test.xlsx", verbose_on, log_debug, 1, nullptr, 0);
+    ASSERT_NE(nullptr, handle);
+    int exist = 0;
+    EXPECT_EQ(ED_getDoubleFromXLSX(handle, "B2", "set1", &exist), 2);
+    EXPECT_EQ(exist, 1);
+    EXPECT_STREQ(ED_getStringFromXLSX(handle, "A2", "set1", &exist), "gain");
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray2DFromXLSX(handle, "A1", "table1", table.data(), 3, 2);
+    EXPECT_EQ(table[2], 0.5);
+    EXPECT_EQ(table[3], 0.25);
+    ED_destroyXLSX(handle);
+}
+
+void getDoubleFromBrokenSheet(int preload) {
+    auto handle = ED_createXLSXPreload("../Examples/test_broken.xlsx", verbose_off, log_debug, preload, nullptr, 0);
+    int exist = 0;
+    ED_getDoubleFromXLSX(handle, "B2", "set1", &exist);
+    if (exist == 1) {
+        ED_getDoubleFromXLSX(handle, "B2", "set2", &exist);
+    }
+    ED_destroyXLSX(handle);
+}
+
+TEST(ED_XLSX, BrokenSheet) {
+    // The parse error of the preloaded sheet is raised on access
+    EXPECT_DEATH(getDoubleFromBrokenSheet(1), "Cannot parse file xl/worksheets/sheet2.xml");
+    EXPECT_DEATH(getDoubleFromBrokenSheet(0), "Cannot parse file xl/worksheets/sheet2.xml");
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
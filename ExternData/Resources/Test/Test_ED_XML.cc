@@ -9,6 +9,8 @@
 #include "../Include/ED_XMLFile.h"
 #include "Constants.h"
 #include <gtest/gtest.h>
+#include <array>
+#include <vector>
 
 namespace
 {
@@ -19,6 +21,115 @@ TEST(ED_XML, Create) {
     ED_destroyXML(handle);
 }
 
+TEST(ED_XML, GetArray2DDimensions) {
+    auto handle = ED_createXML("../Examples/test.xml", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int m, n;
+    ED_getArray2DDimensionsFromXML(handle, "table2", &m, &n);
+    EXPECT_EQ(m, 3);
+    EXPECT_EQ(n, 2);
+    ED_getArray2DDimensionsFromXML(handle, "table3", &m, &n);
+    EXPECT_EQ(m, 3);
+    EXPECT_EQ(n, 2);
+    ED_getArray2DDimensionsFromXML(handle, "table5", &m, &n);
+    EXPECT_EQ(m, 6);
+    EXPECT_EQ(n, 1);
+    ED_destroyXML(handle);
+}
+
+TEST(ED_XML, GetDoubleArray2DFromChildren) {
+    auto handle = ED_createXML("../Examples/test.xml", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    const auto expected = std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1};
+    for (auto varName : {"table1", "table3", "table5"}) {
+        auto table = std::array<double, 6>{};
+        ED_getDoubleArray2DFromXML(handle, varName, table.data(), 3, 2);
+        EXPECT_EQ(table, expected) << varName;
+    }
+    ED_destroyXML(handle);
+}
+
+TEST(ED_XML, GetDoubleArray1DFromSiblings) {
+    auto handle = ED_createXML("../Examples/test.xml", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    /* Siblings are read in document order */
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray1DFromXML(handle, "table4.val", table.data(), 6);
+    EXPECT_EQ(table, (std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1}));
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromXML(handle, "table5.values.val", &exist), 0);
+    EXPECT_EQ(exist, 1);
+    ED_destroyXML(handle);
+}
+
+TEST(ED_XML, GetDoubleArray1DMultiLine) {
+    auto handle = ED_createXML("../Examples/test.xml", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int n;
+    ED_getArray1DDimensionFromXML(handle, "table6", &n);
+    EXPECT_EQ(n, 6);
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray1DFromXML(handle, "table6", table.data(), 6);
+    EXPECT_EQ(table, (std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1}));
+    ED_destroyXML(handle);
+}
+
+TEST(ED_XML, GetValuesAcrossReadChunks) {
+    auto handle = ED_createXML("../Examples/test_large.xml", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int n;
+    ED_getArray1DDimensionFromXML(handle, "values", &n);
+    ASSERT_EQ(n, 15000);
+    // The value 12755 is split by the first chunk boundary
+    auto values = std::vector<double>(15000);
+    ED_getDoubleArray1DFromXML(handle, "values", values.data(), 15000);
+    EXPECT_EQ(values[12753], 12754);
+    EXPECT_EQ(values[12754], 12755);
+    EXPECT_EQ(values[12755], 12756);
+    EXPECT_EQ(values[14999], 15000);
+    // The start tag of splitTag is split by the second chunk boundary
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromXML(handle, "splitTag", &exist), 42);
+    EXPECT_EQ(exist, 1);
+    ED_destroyXML(handle);
+}
+
+void getInvalidDoubleArray1D() {
+    auto handle = ED_createXML("../Examples/test.xml", verbose_off, log_debug);
+    auto table = std::array<double, 8>{};
+    ED_getDoubleArray1DFromXML(handle, "table7", table.data(), 8);
+    ED_destroyXML(handle);
+}
+
+TEST(ED_XML, GetDoubleArray1DInvalidToken) {
+    // The invalid token is beyond the first 16 bytes of the text
+    EXPECT_DEATH(getInvalidDoubleArray1D(), "line 52, position 39: Cannot read double value \"x\"");
+}
+
+TEST(ED_XML, GetValuesFromCachedPaths) {
+    auto handle = ED_createXML("../Examples/test.xml", verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    for (auto i = 0; i < 2; ++i) {
+        EXPECT_EQ(ED_getDoubleFromXML(handle, "set1.gain.k", &exist), 2);
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getDoubleFromXML(handle, "set1.clock.offset", &exist), 0.1);
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getIntFromXML(handle, "set2.gain.k", &exist), -2);
+        EXPECT_EQ(exist, 1);
+        EXPECT_STREQ(ED_getStringFromXML(handle, "set2.clock.offset", &exist), "-0.1");
+        EXPECT_EQ(exist, 1);
+        /* Unresolved paths are not cached */
+        EXPECT_EQ(ED_getDoubleFromXML(handle, "set1.gain.d", &exist), 0);
+        EXPECT_EQ(exist, 0);
+        EXPECT_EQ(ED_getDoubleFromXML(handle, "", &exist), 0);
+        EXPECT_EQ(exist, 0);
+    }
+    EXPECT_EQ(ED_getDoubleFromXML(handle, "set1.gain", &exist), 0);
+    EXPECT_EQ(exist, 0);
+    ED_destroyXML(handle);
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
@@ -9,6 +9,7 @@
 #include "../Include/ED_XML2File.h"
 #include "Constants.h"
 #include <gtest/gtest.h>
+#include <array>
 
 namespace
 {
@@ -20,6 +21,196 @@ TEST(ED_XML2, Create) {
     ED_destroyXML2(handle);
 }
 
+TEST(ED_XML2, GetDoubleArray2D) {
+    const char* ns = "";
+    auto handle = ED_createXML2("../Examples/test.xml", &ns, 0, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    const auto expected = std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1};
+    for (auto varName : {"/dummyRoot/table1", "/dummyRoot/table2"}) {
+        int m, n;
+        ED_getArray2DDimensionsFromXML2(handle, varName, &m, &n);
+        EXPECT_EQ(m * n, 6) << varName;
+        auto table = std::array<double, 6>{};
+        ED_getDoubleArray2DFromXML2(handle, varName, table.data(), 3, 2);
+        EXPECT_EQ(table, expected) << varName;
+    }
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetDoubleArray1DFromAttribute) {
+    const char* ns[] = {"ssv", "http://ssp-standard.org/SSP1/SystemStructureParameterValues"};
+    auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, 1, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    const auto varName = "//ssv:Parameters/ssv:Parameter[@name='vector']/ssv:Float64/@value";
+    int n;
+    ED_getArray1DDimensionFromXML2(handle, varName, &n);
+    EXPECT_EQ(n, 3);
+    auto vector = std::array<double, 3>{};
+    ED_getDoubleArray1DFromXML2(handle, varName, vector.data(), 3);
+    EXPECT_EQ(vector, (std::array<double, 3>{1, 2, 3}));
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetValuesFromCompiledXPath) {
+    const char* ns[] = {"ssv", "http://ssp-standard.org/SSP1/SystemStructureParameterValues"};
+    auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, 1, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    for (auto i = 0; i < 2; ++i) {
+        EXPECT_EQ(ED_getDoubleFromXML2(handle, "/ssv:ParameterSet/@version", &exist), 2);
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getDoubleFromXML2(handle, "//ssv:Parameter[@name='gain.k']/ssv:Float64/@value", &exist), 2);
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getIntFromXML2(handle, "//ssv:Parameter[@name='table1']/*[2]/@size", &exist), 3);
+        EXPECT_EQ(exist, 1);
+        EXPECT_STREQ(ED_getStringFromXML2(handle, "//ssv:Parameter[@name='clock.offset']/ssv:Float64/@value", &exist), "0.1");
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getDoubleFromXML2(handle, "//ssv:Parameter[@name='unknown']/ssv:Float64/@value", &exist), 0);
+        EXPECT_EQ(exist, 0);
+    }
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetValuesFromSSV) {
+    const auto ssvNS = "http://ssp-standard.org/SSP1/SystemStructureParameterValues";
+    const char* ns[] = {"ssv", ssvNS};
+    for (auto fileName : {"../Examples/test_v1.ssv", "../Examples/test_v2.ssv"}) {
+        auto handle = ED_createXML2(fileName, ns, 1, verbose_on, log_debug);
+        ASSERT_NE(nullptr, handle);
+        int exist;
+        EXPECT_EQ(ED_getDoubleFromSSV(handle, "gain.k", ssvNS, &exist), 2);
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getDoubleFromSSV(handle, "clock.offset", ssvNS, &exist), 0.1);
+        EXPECT_EQ(exist, 1);
+        EXPECT_EQ(ED_getIntFromSSV(handle, "gain.k", ssvNS, &exist), 0);
+        EXPECT_EQ(exist, 0);
+        EXPECT_EQ(ED_getDoubleFromSSV(handle, "unknown", ssvNS, &exist), 0);
+        EXPECT_EQ(exist, 0);
+        /* Elements of the SSV name space do not match without name space */
+        EXPECT_EQ(ED_getDoubleFromSSV(handle, "gain.k", "", &exist), 0);
+        EXPECT_EQ(exist, 0);
+        ED_destroyXML2(handle);
+    }
+}
+
+TEST(ED_XML2, GetUnitFromSSV) {
+    const auto ssvNS = "http://ssp-standard.org/SSP1/SystemStructureParameterValues";
+    const char* ns[] = {"ssv", ssvNS};
+    auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, 1, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_STREQ(ED_getUnitFromSSV(handle, "clock.offset", ssvNS, &exist), "s");
+    EXPECT_EQ(exist, 1);
+    EXPECT_STREQ(ED_getUnitFromSSV(handle, "gain.k", ssvNS, &exist), "");
+    EXPECT_EQ(exist, 0);
+    EXPECT_STREQ(ED_getUnitFromSSV(handle, "unknown", ssvNS, &exist), "");
+    EXPECT_EQ(exist, 0);
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetDoubleArrayFromSSV) {
+    const auto ssvNS = "http://ssp-standard.org/SSP1/SystemStructureParameterValues";
+    const char* ns[] = {"ssv", ssvNS, "ssc", "http://ssp-standard.org/SSP1/SystemStructureCommon"};
+    auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, 2, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_EQ(ED_getArrayDimensionFromSSV(handle, "vector", ssvNS, 1, &exist), 3);
+    EXPECT_EQ(exist, 1);
+    ED_getArrayDimensionFromSSV(handle, "vector", ssvNS, 2, &exist);
+    EXPECT_EQ(exist, 0);
+    auto vector = std::array<double, 3>{};
+    ED_getDoubleArray1DFromSSV(handle, "vector", ssvNS, vector.data(), 3);
+    EXPECT_EQ(vector, (std::array<double, 3>{1, 2, 3}));
+    EXPECT_EQ(ED_getArrayDimensionFromSSV(handle, "table1", ssvNS, 1, &exist), 3);
+    EXPECT_EQ(exist, 1);
+    EXPECT_EQ(ED_getArrayDimensionFromSSV(handle, "table1", ssvNS, 2, &exist), 2);
+    EXPECT_EQ(exist, 1);
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray2DFromSSV(handle, "table1", ssvNS, table.data(), 3, 2);
+    EXPECT_EQ(table, (std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1}));
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetArrayDimensionFromSSVWithoutSSC) {
+    // Dimension elements are only found by the name space registered for ssc
+    const auto ssvNS = "http://ssp-standard.org/SSP1/SystemStructureParameterValues";
+    for (auto sscNS : {"", "urn:other"}) {
+        const char* ns[] = {"ssv", ssvNS, "ssc", sscNS};
+        auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, sscNS[0] == '\0' ? 1 : 2, verbose_on, log_debug);
+        ASSERT_NE(nullptr, handle);
+        int exist = 1;
+        ED_getArrayDimensionFromSSV(handle, "vector", ssvNS, 1, &exist);
+        EXPECT_EQ(exist, 0);
+        ED_destroyXML2(handle);
+    }
+}
+
+void getInvalidDoubleArrayFromSSV() {
+    const auto ssvNS = "http://ssp-standard.org/SSP1/SystemStructureParameterValues";
+    const char* ns[] = {"ssv", ssvNS};
+    auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, 1, verbose_off, log_debug);
+    auto vector = std::array<double, 3>{};
+    ED_getDoubleArray1DFromSSV(handle, "invalid", ssvNS, vector.data(), 3);
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetInvalidDoubleArrayFromSSV) {
+    EXPECT_DEATH(getInvalidDoubleArrayFromSSV(), "line 23, position 5: Cannot read double value \"x3\"");
+}
+
+void getInvalidDoubleFromXML2(bool isArray) {
+    const char* ns[] = {"ssv", "http://ssp-standard.org/SSP1/SystemStructureParameterValues"};
+    auto handle = ED_createXML2("../Examples/test_v2.ssv", ns, 1, verbose_off, log_debug);
+    const auto varName = "//ssv:Parameter[@name='invalid']/ssv:Float64/@value";
+    if (isArray) {
+        auto vector = std::array<double, 3>{};
+        ED_getDoubleArray1DFromXML2(handle, varName, vector.data(), 3);
+    }
+    else {
+        int exist;
+        ED_getDoubleFromXML2(handle, varName, &exist);
+    }
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, GetInvalidDoubleFromXML2) {
+    // The text is reported after the XPath result is freed
+    EXPECT_DEATH(getInvalidDoubleFromXML2(true), "position 5: Cannot read double value \"x3\" from file");
+    EXPECT_DEATH(getInvalidDoubleFromXML2(false), "Cannot read double value \"1 2 x3\" from file");
+}
+
+TEST(ED_XML2, CreateStreaming) {
+    const char* ns = "";
+    const char* patterns[] = {"/dummyRoot/set1", "/dummyRoot/table1"};
+    auto handle = ED_createXML2Streaming("../Examples/test.xml", &ns, 0, patterns, 2, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromXML2(handle, "/dummyRoot/set1/gain/k", &exist), 2);
+    EXPECT_EQ(exist, 1);
+    auto table = std::array<double, 6>{};
+    ED_getDoubleArray2DFromXML2(handle, "/dummyRoot/table1", table.data(), 3, 2);
+    EXPECT_EQ(table, (std::array<double, 6>{0, 0, 0.5, 0.25, 1, 1}));
+    /* Subtrees not matching any pattern are dropped */
+    ED_getDoubleFromXML2(handle, "/dummyRoot/set2/gain/k", &exist);
+    EXPECT_EQ(exist, 0);
+    ED_destroyXML2(handle);
+}
+
+TEST(ED_XML2, CreateStreamingSSV) {
+    const auto ssvNS = "http://ssp-standard.org/SSP1/SystemStructureParameterValues";
+    const char* ns[] = {"ssv", ssvNS};
+    const char* patterns[] = {"//ssv:Parameter"};
+    auto handle = ED_createXML2Streaming("../Examples/test_v2.ssv", ns, 1, patterns, 1, verbose_on, log_debug);
+    ASSERT_NE(nullptr, handle);
+    int exist;
+    EXPECT_EQ(ED_getDoubleFromSSV(handle, "gain.k", ssvNS, &exist), 2);
+    EXPECT_EQ(exist, 1);
+    auto vector = std::array<double, 3>{};
+    ED_getDoubleArray1DFromSSV(handle, "vector", ssvNS, vector.data(), 3);
+    EXPECT_EQ(vector, (std::array<double, 3>{1, 2, 3}));
+    ED_destroyXML2(handle);
+}
+
 }  // namespace
 
 int main(int argc, char **argv)